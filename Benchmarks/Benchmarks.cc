@@ -0,0 +1,396 @@
+#include "ByteSize.h"
+#include "BitSize.h"
+#include "SizeClassMap.h"
+#include "MemoryAccount.h"
+#include "MemorySampler.h"
+#include "NetworkSampler.h"
+#include "SizeLogger.h"
+#include "SharedCounters.h"
+#include "MetricsExporter.h"
+#include "SizeFormat.h"
+#include "RateLimiter.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Microbenchmarks for the operations that are called most often. Each benchmark is run in batches of increasing size until a batch takes at
+// least the minimum time, and reports the time and number of heap allocations per operation of that batch.
+// Usage: Benchmarks [filter] [--min-time=<seconds>]
+
+static std::atomic<std::size_t> allocation_count(0);
+
+void* operator new(std::size_t size) {
+
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* pointer = std::malloc(size == 0 ? 1 : size))
+		return pointer;
+
+	throw std::bad_alloc();
+
+}
+void operator delete(void* pointer) noexcept {
+
+	std::free(pointer);
+
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+
+	std::free(pointer);
+
+}
+
+namespace {
+
+	using namespace hvn3;
+
+	// Keeps the compiler from optimizing away a result that is otherwise unused.
+	template <typename T>
+	inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile char sink;
+		sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+	}
+
+	// Inputs are read from small tables indexed by the iteration, so that they are not known at compile time. The sizes span every unit
+	// from bytes to tebibytes.
+	const std::size_t INPUT_MASK = 7;
+	const double DOUBLE_INPUTS[] = { 0.3, 512.0, 1536.0, 1048576.0, 5.5e6, 1073741824.0, 7.25e10, 1099511627776.0 };
+	const std::int64_t INTEGER_INPUTS[] = { 1, 512, 1536, 1048576, 5500000, 1073741824, 72500000000, 1099511627776 };
+	const char* const VALID_STRINGS[] = { "1 B", "512 B", "1.5 KiB", "1 MiB", "5.5 MB", "1 GiB", "72.5 GB", "1 TiB" };
+	const char* const INVALID_STRINGS[] = { "", "KiB", "1.5 XB", "1..5 MiB", "abc", "1 GiBs", "- 1 B", "1e" };
+
+	double min_seconds = 0.2;
+	const char* filter = "";
+
+	template <typename Function>
+	void Run(const char* name, Function function) {
+
+		if (std::strstr(name, filter) == nullptr)
+			return;
+
+		typedef std::chrono::steady_clock clock;
+
+		for (std::size_t iterations = 1; ; iterations *= 2) {
+
+			std::size_t allocations = allocation_count.load(std::memory_order_relaxed);
+			clock::time_point start = clock::now();
+
+			for (std::size_t i = 0; i < iterations; ++i)
+				function(i);
+
+			double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+			allocations = allocation_count.load(std::memory_order_relaxed) - allocations;
+
+			if (seconds >= min_seconds || iterations >= (std::size_t(1) << 40)) {
+
+				std::printf("%-32s %12.2f ns/op %10.2f allocs/op\n", name, seconds * 1e9 / iterations, static_cast<double>(allocations) / iterations);
+
+				return;
+
+			}
+
+		}
+
+	}
+
+	void RunConstructorBenchmarks() {
+
+		Run("Construct/Double", [](std::size_t i) {
+			DoNotOptimize(ByteSize(DOUBLE_INPUTS[i & INPUT_MASK]));
+		});
+		Run("Construct/Integer", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]));
+		});
+		Run("Construct/FromMegabytes", [](std::size_t i) {
+			DoNotOptimize(ByteSize::FromMegabytes(DOUBLE_INPUTS[i & INPUT_MASK]));
+		});
+		Run("RoundBytesToNearestBit", [](std::size_t i) {
+			DoNotOptimize(RoundBytesToNearestBit(DOUBLE_INPUTS[i & INPUT_MASK]));
+		});
+
+	}
+	void RunFormattingBenchmarks() {
+
+		Run("ToString/Precision0", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).ToString(0));
+		});
+		Run("ToString/Precision2", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).ToString(2));
+		});
+		Run("ToString/Precision6", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).ToString(6));
+		});
+		Run("ToString/Decimal", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK], BytePrefix::Decimal).ToString());
+		});
+		Run("ToString/JEDEC", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK], BytePrefix::Binary, ByteUnit::JEDEC).ToString());
+		});
+		Run("ToString/BitSize", [](std::size_t i) {
+			DoNotOptimize(BitSize(INTEGER_INPUTS[i & INPUT_MASK]).ToString());
+		});
+		Run("ToChars/Precision2", [](std::size_t i) {
+			char buffer[32];
+			std::to_chars_result result = ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).ToChars(buffer, buffer + sizeof(buffer));
+			DoNotOptimize(result.ptr);
+		});
+
+		// Columns of 1024 sizes, formatted with a unit chosen per size and then with one unit for the whole column.
+		static std::int64_t column[1024];
+		static char records[1024 * 16];
+
+		for (std::size_t i = 0; i < 1024; ++i)
+			column[i] = INTEGER_INPUTS[i & INPUT_MASK] + static_cast<std::int64_t>(i);
+
+		Run("FormatManyFixedWidth/1024", [](std::size_t) {
+			DoNotOptimize(ByteSize::FormatManyFixedWidth(column, 1024, records, 16).ptr);
+		});
+		Run("FormatColumn/1024", [](std::size_t) {
+			ByteSize::FormatColumn(column, 1024, ByteSize::MeasureColumn(column, 1024), records, 16);
+			DoNotOptimize(records);
+		});
+
+	}
+	void RunParsingBenchmarks() {
+
+		Run("Parse/Valid", [](std::size_t i) {
+			DoNotOptimize(ByteSize::Parse(std::string_view(VALID_STRINGS[i & INPUT_MASK])));
+		});
+		Run("Parse/Invalid", [](std::size_t i) {
+			try {
+				DoNotOptimize(ByteSize::Parse(std::string_view(INVALID_STRINGS[i & INPUT_MASK])));
+			}
+			catch (const std::invalid_argument&) {
+			}
+		});
+		Run("TryParse/Valid", [](std::size_t i) {
+			ByteSize size(0);
+			DoNotOptimize(ByteSize::TryParse(std::string_view(VALID_STRINGS[i & INPUT_MASK]), size));
+			DoNotOptimize(size);
+		});
+		Run("TryParse/Invalid", [](std::size_t i) {
+			ByteSize size(0);
+			DoNotOptimize(ByteSize::TryParse(std::string_view(INVALID_STRINGS[i & INPUT_MASK]), size));
+			DoNotOptimize(size);
+		});
+		Run("TryParse/String", [](std::size_t i) {
+			ByteSize size(0);
+			DoNotOptimize(ByteSize::TryParse(std::string(VALID_STRINGS[i & INPUT_MASK]), size));
+			DoNotOptimize(size);
+		});
+
+	}
+	void RunAccessorBenchmarks() {
+
+		Run("Accessors/Bytes", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).Bytes());
+		});
+		Run("Accessors/Kilobytes", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).Kilobytes());
+		});
+		Run("Accessors/Gigabytes", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).Gigabytes());
+		});
+		Run("Accessors/LargestUnit", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).LargestUnit());
+		});
+		Run("Accessors/LargestUnitSymbol", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).LargestUnitSymbol());
+		});
+
+	}
+	void RunOperatorBenchmarks() {
+
+		Run("Compare/Equal", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]) == ByteSize(INTEGER_INPUTS[(i + 1) & INPUT_MASK]));
+		});
+		Run("Compare/Less", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]) < ByteSize(INTEGER_INPUTS[(i + 1) & INPUT_MASK]));
+		});
+		Run("Arithmetic/Add", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]) + ByteSize(INTEGER_INPUTS[(i + 1) & INPUT_MASK]));
+		});
+		Run("Arithmetic/Subtract", [](std::size_t i) {
+			DoNotOptimize(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]) - ByteSize(INTEGER_INPUTS[(i + 1) & INPUT_MASK]));
+		});
+		Run("Arithmetic/AddBytes", [](std::size_t i) {
+			ByteSize size(INTEGER_INPUTS[i & INPUT_MASK]);
+			size.AddBytes(DOUBLE_INPUTS[(i + 1) & INPUT_MASK]);
+			DoNotOptimize(size);
+		});
+
+	}
+	void RunSizeClassBenchmarks() {
+
+		static const SizeClassMap classes({ ByteSize(1024), ByteSize(65536), ByteSize(1048576), ByteSize(16777216), ByteSize(1073741824), ByteSize(1099511627776) });
+
+		Run("SizeClassMap/ClassIndex", [](std::size_t i) {
+			DoNotOptimize(classes.ClassIndex(static_cast<std::uint64_t>(INTEGER_INPUTS[i & INPUT_MASK])));
+		});
+
+	}
+	void RunMemoryAccountBenchmarks() {
+
+		static MemoryAccount account("benchmark");
+
+		// Typical small allocations, from 16 to 128 bytes.
+		Run("MemoryAccount/AllocateDeallocate", [](std::size_t i) {
+			std::size_t bytes = ((i & INPUT_MASK) + 1) * 16;
+			account.Allocate(bytes);
+			account.Deallocate(bytes);
+		});
+
+	}
+	void RunMemorySamplerBenchmarks() {
+
+		static MemorySampler sampler;
+
+		Run("MemorySampler/Sample", [](std::size_t) {
+			MemorySample sample;
+			DoNotOptimize(sampler.Sample(sample));
+		});
+		Run("MemorySampler/Resident", [](std::size_t) {
+			DoNotOptimize(sampler.Resident());
+		});
+
+	}
+	void RunNetworkSamplerBenchmarks() {
+
+		static NetworkSampler sampler;
+
+		Run("NetworkSampler/Sample", [](std::size_t) {
+			DoNotOptimize(sampler.Sample().size());
+		});
+
+	}
+	void RunSizeLoggerBenchmarks() {
+
+		// Records the cost on the logging thread only. Records that don't fit in the buffer are dropped.
+		static SizeLogger logger([](std::string_view line) { DoNotOptimize(line.size()); }, 1 << 16);
+
+		Run("SizeLogger/Log", [](std::size_t i) {
+			DoNotOptimize(logger.Log("size", ByteSize(INTEGER_INPUTS[i & INPUT_MASK])));
+		});
+		Run("SizeLogger/FormatInline", [](std::size_t i) {
+			DoNotOptimize(std::string("size ") + ByteSize(INTEGER_INPUTS[i & INPUT_MASK]).ToString());
+		});
+
+	}
+	void RunSharedCounterBenchmarks() {
+
+#if defined(__linux__)
+
+		static SharedCounterRegion region("ByteSizeBenchmarks." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+		static std::size_t counter = region.AddCounter("bytes");
+
+		Run("SharedCounterRegion/Add", [](std::size_t i) {
+			region.Add(counter, ByteSize(INTEGER_INPUTS[i & INPUT_MASK]));
+		});
+
+#endif
+
+	}
+	void RunMetricsExporterBenchmarks() {
+
+		// A thousand gauges with two labels each, and ten histograms.
+		static ByteSizeHistogram histogram;
+		static MetricsExporter exporter;
+		static bool initialized = [] {
+
+			for (std::size_t i = 0; i < 1000; ++i)
+				exporter.AddGauge("volume_size", [i] { return ByteSize(INTEGER_INPUTS[i & INPUT_MASK]); }, { { "host", "server-01" }, { "volume", std::to_string(i) } });
+
+			for (std::size_t i = 0; i < 10; ++i)
+				exporter.AddHistogram("request_size", histogram, MetricsExporter::DefaultBoundaries(), { { "route", std::to_string(i) } });
+
+			for (std::size_t i = 0; i < 100000; ++i)
+				histogram.Record(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]));
+
+			return true;
+
+		}();
+
+		DoNotOptimize(initialized);
+
+		Run("MetricsExporter/Render", [](std::size_t) {
+			DoNotOptimize(exporter.Render().size());
+		});
+
+	}
+
+	void RunSizeFormatBenchmarks() {
+
+		static const SizeFormat format(">12,.1iec");
+
+		Run("SizeFormat/Format", [](std::size_t i) {
+			char buffer[32];
+			std::to_chars_result result = format.Format(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]), buffer, buffer + sizeof(buffer));
+			DoNotOptimize(result.ptr);
+		});
+		Run("SizeFormat/ParseAndFormat", [](std::size_t i) {
+			char buffer[32];
+			std::to_chars_result result = SizeFormat(">12,.1iec").Format(ByteSize(INTEGER_INPUTS[i & INPUT_MASK]), buffer, buffer + sizeof(buffer));
+			DoNotOptimize(result.ptr);
+		});
+		Run("SizeFormat/ToString", [](std::size_t i) {
+			DoNotOptimize(format.ToString(ByteSize(INTEGER_INPUTS[i & INPUT_MASK])));
+		});
+
+	}
+
+	void RunRateLimiterBenchmarks() {
+
+		// A limit that is never reached, so that every acquisition succeeds and only its cost is measured.
+		static RateLimiter limiter(ByteRate::Parse("1 PiB/s"), ByteSize::Parse("1 TiB"));
+
+		Run("RateLimiter/TryAcquire", [](std::size_t i) {
+			DoNotOptimize(limiter.TryAcquire(ByteSize(INTEGER_INPUTS[i & 3])));
+		});
+		Run("RateLimiter/Acquire", [](std::size_t i) {
+			limiter.Acquire(ByteSize(INTEGER_INPUTS[i & 3]));
+		});
+
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+
+	for (int i = 1; i < argc; ++i) {
+
+		if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+			min_seconds = std::atof(argv[i] + 11);
+		else
+			filter = argv[i];
+
+	}
+
+	RunConstructorBenchmarks();
+	RunFormattingBenchmarks();
+	RunParsingBenchmarks();
+	RunAccessorBenchmarks();
+	RunOperatorBenchmarks();
+	RunSizeClassBenchmarks();
+	RunMemoryAccountBenchmarks();
+	RunMemorySamplerBenchmarks();
+	RunNetworkSamplerBenchmarks();
+	RunSizeLoggerBenchmarks();
+	RunSharedCounterBenchmarks();
+	RunMetricsExporterBenchmarks();
+	RunSizeFormatBenchmarks();
+	RunRateLimiterBenchmarks();
+
+	return 0;
+
+}
@@ -0,0 +1,33 @@
+#include "AtomicSize.h"
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE std::size_t CurrentShardHint() {
+
+#if defined(__linux__)
+		// With restartable sequences, glibc answers this from memory shared with the kernel, without a system call.
+		int cpu = sched_getcpu();
+
+		if (cpu >= 0)
+			return static_cast<std::size_t>(cpu);
+#endif
+
+		// Otherwise give each thread its own shard in turn, which spreads threads out as long as there are not too many of them.
+		static std::atomic<std::size_t> next_shard(0);
+		thread_local std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+
+		return shard;
+
+	}
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	template class BasicAtomicSize<ByteTraits>;
+	template class BasicAtomicSize<BitTraits>;
+	template class BasicShardedAtomicSize<ByteTraits>;
+	template class BasicShardedAtomicSize<BitTraits>;
+#endif
+
+}
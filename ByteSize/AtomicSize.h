@@ -0,0 +1,122 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hvn3 {
+
+	// Size of the cache lines that shards are padded to, so updates to neighbouring shards don't contend.
+	constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+	// A size that can be updated from many threads at once without a lock.
+	// The bit count is kept in a lock-free std::atomic<std::int64_t>, even when BitCount is 128 bits wide. Unlike BasicSize, arithmetic wraps
+	// instead of saturating, since saturating would require a compare-and-swap loop.
+	template <typename Traits, typename PrefixPolicy = DynamicPrefix>
+	class BasicAtomicSize :
+		private PrefixPolicy {
+
+	public:
+		typedef BasicSize<Traits, PrefixPolicy> size_type;
+
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixPolicy::DEFAULT_PREFIX;
+
+		explicit BasicAtomicSize(BytePrefix prefix = DEFAULT_PREFIX);
+		explicit BasicAtomicSize(const size_type& size);
+		BasicAtomicSize(const BasicAtomicSize&) = delete;
+
+		BytePrefix Prefix() const;
+		ByteUnit Unit() const;
+
+		size_type Load(std::memory_order order = std::memory_order_seq_cst) const;
+		void Store(const size_type& size, std::memory_order order = std::memory_order_seq_cst);
+		size_type Exchange(const size_type& size, std::memory_order order = std::memory_order_seq_cst);
+
+		// Adds or subtracts size and returns the previous value.
+		size_type FetchAdd(const size_type& size, std::memory_order order = std::memory_order_seq_cst);
+		size_type FetchSub(const size_type& size, std::memory_order order = std::memory_order_seq_cst);
+
+		std::string ToString(unsigned int precision = 2) const;
+
+		BasicAtomicSize& operator=(const BasicAtomicSize&) = delete;
+		// Returns the new value, like the compound operators of std::atomic.
+		size_type operator+=(const size_type& rhs);
+		size_type operator-=(const size_type& rhs);
+
+	private:
+		size_type FromCount(std::int64_t bits) const;
+
+		std::atomic<std::int64_t> _bits;
+
+	};
+
+	// A counter split into cache-line-padded shards, one per CPU where the platform can say which CPU a thread is running on.
+	// Each thread updates its own shard, so frequent updates from many threads don't all contend on one cache line. Reading sums the shards
+	// and is approximate while updates are in progress.
+	template <typename Traits, typename PrefixPolicy = DynamicPrefix>
+	class BasicShardedAtomicSize :
+		private PrefixPolicy {
+
+	public:
+		typedef BasicSize<Traits, PrefixPolicy> size_type;
+
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixPolicy::DEFAULT_PREFIX;
+
+		// shardCount is rounded up to a power of two. Zero uses one shard per hardware thread.
+		explicit BasicShardedAtomicSize(BytePrefix prefix = DEFAULT_PREFIX, std::size_t shardCount = 0);
+		BasicShardedAtomicSize(const BasicShardedAtomicSize&) = delete;
+
+		BytePrefix Prefix() const;
+		ByteUnit Unit() const;
+		std::size_t ShardCount() const;
+
+		void Add(const size_type& size);
+		void Subtract(const size_type& size);
+
+		// Returns the sum of all shards.
+		size_type Load() const;
+		// Returns the sum of all shards and sets them to zero. Updates made concurrently are counted either now or by the next call.
+		size_type Reset();
+
+		std::string ToString(unsigned int precision = 2) const;
+
+		BasicShardedAtomicSize& operator=(const BasicShardedAtomicSize&) = delete;
+		BasicShardedAtomicSize& operator+=(const size_type& rhs);
+		BasicShardedAtomicSize& operator-=(const size_type& rhs);
+
+	private:
+		struct alignas(CACHE_LINE_SIZE) Shard {
+			std::atomic<std::int64_t> bits;
+		};
+
+		std::atomic<std::int64_t>& CurrentShard();
+
+		std::unique_ptr<Shard[]> _shards;
+		std::size_t _shard_mask;
+
+	};
+
+	// Returns a number identifying the CPU the calling thread is running on, or failing that, a number that differs between threads.
+	std::size_t CurrentShardHint();
+
+	using AtomicByteSize = BasicAtomicSize<ByteTraits>;
+	using AtomicBitSize = BasicAtomicSize<BitTraits>;
+	using ShardedAtomicByteSize = BasicShardedAtomicSize<ByteTraits>;
+	using ShardedAtomicBitSize = BasicShardedAtomicSize<BitTraits>;
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	extern template class BasicAtomicSize<ByteTraits>;
+	extern template class BasicAtomicSize<BitTraits>;
+	extern template class BasicShardedAtomicSize<ByteTraits>;
+	extern template class BasicShardedAtomicSize<BitTraits>;
+#endif
+
+}
+
+#include "AtomicSize.inl"
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "AtomicSize.cc"
+#endif
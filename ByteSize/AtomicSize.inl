@@ -0,0 +1,197 @@
+#pragma once
+
+namespace hvn3 {
+
+	template <typename Traits, typename PrefixPolicy>
+	BasicAtomicSize<Traits, PrefixPolicy>::BasicAtomicSize(BytePrefix prefix) :
+		PrefixPolicy(prefix, prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric),
+		_bits(0) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicAtomicSize<Traits, PrefixPolicy>::BasicAtomicSize(const size_type& size) :
+		PrefixPolicy(size.Prefix(), size.Unit()),
+		_bits(static_cast<std::int64_t>(size.ExactBits())) {
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BytePrefix BasicAtomicSize<Traits, PrefixPolicy>::Prefix() const {
+
+		return PrefixPolicy::Prefix();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline ByteUnit BasicAtomicSize<Traits, PrefixPolicy>::Unit() const {
+
+		return PrefixPolicy::Unit();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::Load(std::memory_order order) const {
+
+		return FromCount(_bits.load(order));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicAtomicSize<Traits, PrefixPolicy>::Store(const size_type& size, std::memory_order order) {
+
+		_bits.store(static_cast<std::int64_t>(size.ExactBits()), order);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::Exchange(const size_type& size, std::memory_order order) {
+
+		return FromCount(_bits.exchange(static_cast<std::int64_t>(size.ExactBits()), order));
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::FetchAdd(const size_type& size, std::memory_order order) {
+
+		return FromCount(_bits.fetch_add(static_cast<std::int64_t>(size.ExactBits()), order));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::FetchSub(const size_type& size, std::memory_order order) {
+
+		return FromCount(_bits.fetch_sub(static_cast<std::int64_t>(size.ExactBits()), order));
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicAtomicSize<Traits, PrefixPolicy>::ToString(unsigned int precision) const {
+
+		return Load().ToString(precision);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::operator+=(const size_type& rhs) {
+
+		std::int64_t bits = static_cast<std::int64_t>(rhs.ExactBits());
+
+		return FromCount(static_cast<std::int64_t>(static_cast<std::uint64_t>(_bits.fetch_add(bits)) + static_cast<std::uint64_t>(bits)));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::operator-=(const size_type& rhs) {
+
+		std::int64_t bits = static_cast<std::int64_t>(rhs.ExactBits());
+
+		return FromCount(static_cast<std::int64_t>(static_cast<std::uint64_t>(_bits.fetch_sub(bits)) - static_cast<std::uint64_t>(bits)));
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicAtomicSize<Traits, PrefixPolicy>::size_type BasicAtomicSize<Traits, PrefixPolicy>::FromCount(std::int64_t bits) const {
+
+		return size_type::FromExactBits(bits, Prefix());
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	BasicShardedAtomicSize<Traits, PrefixPolicy>::BasicShardedAtomicSize(BytePrefix prefix, std::size_t shardCount) :
+		PrefixPolicy(prefix, prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric) {
+
+		std::size_t count = 1;
+
+		for (std::size_t target = shardCount == 0 ? HardwareConcurrency() : shardCount; count < target; count *= 2)
+			;
+
+		_shards.reset(new Shard[count]);
+		_shard_mask = count - 1;
+
+		for (std::size_t i = 0; i < count; ++i)
+			_shards[i].bits.store(0, std::memory_order_relaxed);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BytePrefix BasicShardedAtomicSize<Traits, PrefixPolicy>::Prefix() const {
+
+		return PrefixPolicy::Prefix();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline ByteUnit BasicShardedAtomicSize<Traits, PrefixPolicy>::Unit() const {
+
+		return PrefixPolicy::Unit();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline std::size_t BasicShardedAtomicSize<Traits, PrefixPolicy>::ShardCount() const {
+
+		return _shard_mask + 1;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicShardedAtomicSize<Traits, PrefixPolicy>::Add(const size_type& size) {
+
+		CurrentShard().fetch_add(static_cast<std::int64_t>(size.ExactBits()), std::memory_order_relaxed);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicShardedAtomicSize<Traits, PrefixPolicy>::Subtract(const size_type& size) {
+
+		CurrentShard().fetch_sub(static_cast<std::int64_t>(size.ExactBits()), std::memory_order_relaxed);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	typename BasicShardedAtomicSize<Traits, PrefixPolicy>::size_type BasicShardedAtomicSize<Traits, PrefixPolicy>::Load() const {
+
+		// Summed unsigned, so that it wraps like the shards' own additions do: a total that fits is exact even if a partial sum doesn't.
+		std::uint64_t bits = 0;
+
+		for (std::size_t i = 0; i <= _shard_mask; ++i)
+			bits += static_cast<std::uint64_t>(_shards[i].bits.load(std::memory_order_relaxed));
+
+		return size_type::FromExactBits(static_cast<std::int64_t>(bits), Prefix());
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	typename BasicShardedAtomicSize<Traits, PrefixPolicy>::size_type BasicShardedAtomicSize<Traits, PrefixPolicy>::Reset() {
+
+		// Summed unsigned, as in Load.
+		std::uint64_t bits = 0;
+
+		for (std::size_t i = 0; i <= _shard_mask; ++i)
+			bits += static_cast<std::uint64_t>(_shards[i].bits.exchange(0, std::memory_order_relaxed));
+
+		return size_type::FromExactBits(static_cast<std::int64_t>(bits), Prefix());
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicShardedAtomicSize<Traits, PrefixPolicy>::ToString(unsigned int precision) const {
+
+		return Load().ToString(precision);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicShardedAtomicSize<Traits, PrefixPolicy>& BasicShardedAtomicSize<Traits, PrefixPolicy>::operator+=(const size_type& rhs) {
+
+		Add(rhs);
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicShardedAtomicSize<Traits, PrefixPolicy>& BasicShardedAtomicSize<Traits, PrefixPolicy>::operator-=(const size_type& rhs) {
+
+		Subtract(rhs);
+
+		return *this;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline std::atomic<std::int64_t>& BasicShardedAtomicSize<Traits, PrefixPolicy>::CurrentShard() {
+
+		return _shards[CurrentShardHint() & _shard_mask].bits;
+
+	}
+
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include "ByteSizeCommon.h"
+#include "ByteSizeParser.h"
+#include "SizeQuantity.h"
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace hvn3 {
+
+	// Prefix policy that stores the prefix and unit system in each object, so they can be chosen at runtime (e.g. by Parse).
+	class DynamicPrefix {
+
+	public:
+		static constexpr BytePrefix DEFAULT_PREFIX = BytePrefix::Binary;
+
+		constexpr DynamicPrefix(BytePrefix prefix, ByteUnit unit) noexcept :
+			_prefix(prefix),
+			_unit(unit) {
+		}
+
+		static constexpr BytePrefix Resolve(BytePrefix prefix) noexcept {
+			return prefix;
+		}
+
+		constexpr BytePrefix Prefix() const noexcept {
+			return _prefix;
+		}
+		constexpr ByteUnit Unit() const noexcept {
+			return _unit;
+		}
+
+	private:
+		BytePrefix _prefix;
+		ByteUnit _unit;
+
+	};
+
+	// Prefix policy that fixes the prefix and unit system at compile time, so unit multipliers and symbols fold to constants.
+	// Prefixes passed to constructors and factory methods are ignored.
+	template <BytePrefix PrefixValue, ByteUnit UnitValue = PrefixValue == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric>
+	class StaticPrefix {
+
+	public:
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixValue;
+
+		constexpr StaticPrefix(BytePrefix, ByteUnit) noexcept {
+		}
+
+		static constexpr BytePrefix Resolve(BytePrefix) noexcept {
+			return PrefixValue;
+		}
+
+		static constexpr BytePrefix Prefix() noexcept {
+			return PrefixValue;
+		}
+		static constexpr ByteUnit Unit() noexcept {
+			return UnitValue;
+		}
+
+	};
+
+	// A quantity stored as an exact number of bits and displayed in the units described by Traits (see ByteTraits and BitTraits).
+	// Traits::Accessors provides the unit-specific names (Kilobytes(), FromMegabits(), ...) on top of the generic members below.
+	template <typename Traits, typename PrefixPolicy = DynamicPrefix>
+	class BasicSize :
+		public Traits::template Accessors<BasicSize<Traits, PrefixPolicy>>,
+		private PrefixPolicy {
+
+	public:
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixPolicy::DEFAULT_PREFIX;
+
+		constexpr BasicSize(double bytes, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+		constexpr BasicSize(double bytes, BytePrefix prefix, ByteUnit unit) noexcept;
+		template <typename IntegerType, typename std::enable_if<std::is_integral<IntegerType>::value, int>::type = 0>
+		constexpr BasicSize(IntegerType bytes, BytePrefix prefix = DEFAULT_PREFIX) noexcept :
+			BasicSize(BitsTag(), BytesToBits(bytes), prefix, DefaultUnit(prefix)) {
+		}
+		template <typename IntegerType, typename std::enable_if<std::is_integral<IntegerType>::value, int>::type = 0>
+		constexpr BasicSize(IntegerType bytes, BytePrefix prefix, ByteUnit unit) noexcept :
+			BasicSize(BitsTag(), BytesToBits(bytes), prefix, unit) {
+		}
+		template <typename OtherTraits, typename OtherPrefixPolicy>
+		explicit BasicSize(const BasicSize<OtherTraits, OtherPrefixPolicy>& other);
+		// The prefix defaults to the one the quantity's unit belongs to, so 64_KiB is binary and 10_Gbit is decimal.
+		template <typename Rep, typename Period>
+		constexpr BasicSize(const SizeQuantity<Rep, Period>& size) noexcept :
+			BasicSize(size, QuantityPrefix<Period>(DEFAULT_PREFIX)) {
+		}
+		template <typename Rep, typename Period>
+		constexpr BasicSize(const SizeQuantity<Rep, Period>& size, BytePrefix prefix) noexcept :
+			BasicSize(BitsTag(), QuantityToBits(size), prefix, DefaultUnit(prefix)) {
+		}
+
+		constexpr BitCount ExactBits() const noexcept;
+		constexpr BytePrefix Prefix() const noexcept;
+		constexpr ByteUnit Unit() const noexcept;
+
+		constexpr double Bits() const noexcept;
+		constexpr double Bytes() const noexcept;
+		constexpr double Units(int magnitude) const noexcept;
+
+		// Returns the largest unit in which the size is at least one, with the size in that unit and its symbol.
+		UnitSelection LargestUnit() const;
+		std::string LargestUnitSymbol() const;
+		double LargestUnitValue() const;
+
+		constexpr void AddBits(double size) noexcept;
+		constexpr void AddBytes(double size) noexcept;
+		constexpr void AddUnits(int magnitude, double size) noexcept;
+
+		std::string ToString(unsigned int precision = 2) const;
+		std::to_chars_result ToChars(char* first, char* last, unsigned int precision = 2) const;
+
+		// Formats many counts (bytes for ByteSize, bits for BitSize) as ToString would, one after another into [first, last).
+		// offsets[i] receives the offset of the i-th string and offsets[size] the end of the last one, so offsets needs size + 1 elements.
+		// If the buffer is too small, ec is set to std::errc::value_too_large and the offsets of the strings already written are kept.
+		static std::to_chars_result FormatMany(const std::int64_t* counts, std::size_t size, char* first, char* last, std::size_t* offsets, unsigned int precision = 2, ByteUnit unit = DefaultUnit(DEFAULT_PREFIX));
+		// Formats many counts into consecutive records of width characters each, right-aligned and padded with spaces.
+		static std::to_chars_result FormatManyFixedWidth(const std::int64_t* counts, std::size_t size, char* records, std::size_t width, unsigned int precision = 2, ByteUnit unit = DefaultUnit(DEFAULT_PREFIX));
+		// Formats a column of counts in two passes, so that every count is shown in the same unit with the same width (e.g. for a table).
+		// MeasureColumn chooses the largest unit in which the count of largest magnitude is at least one, and the width of the longest string.
+		// FormatColumn then writes each count into records + i * stride, right-aligned in layout.width characters and padded with spaces,
+		// and leaves the characters in between untouched (a stride of layout.width writes consecutive records). threadCount threads share the
+		// work on large columns; zero uses one per hardware thread. Nothing is allocated on a single thread.
+		static ColumnLayout MeasureColumn(const std::int64_t* counts, std::size_t size, unsigned int precision = 2, ByteUnit unit = DefaultUnit(DEFAULT_PREFIX));
+		static void FormatColumn(const std::int64_t* counts, std::size_t size, const ColumnLayout& layout, char* records, std::size_t stride, std::size_t threadCount = 1);
+
+		static constexpr BasicSize MinValue() noexcept;
+		static constexpr BasicSize MaxValue() noexcept;
+
+		// Parsing is constexpr: a constexpr size initialized from a malformed string fails to compile.
+		static BasicSize Parse(const std::string& string);
+		static constexpr BasicSize Parse(const char* string);
+		static constexpr BasicSize Parse(std::string_view string);
+		static bool TryParse(const std::string& string, BasicSize& object);
+		static bool TryParse(const char* string, BasicSize& object);
+		static constexpr ParseResult TryParse(std::string_view string, BasicSize& object);
+		// Parses one size per line from a column of delimited text into exact bit counts (see ParseSizes).
+		static ParseManyResult ParseMany(std::string_view buffer, BitCount* counts, std::size_t countsSize, std::size_t* invalidRows, std::size_t invalidRowsSize, const ParseManyOptions& options = ParseManyOptions());
+
+		static constexpr BasicSize FromExactBits(BitCount size, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+		static constexpr BasicSize FromBits(double size, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+		static constexpr BasicSize FromBytes(double size, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+		static constexpr BasicSize FromUnits(int magnitude, double size, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+
+		static constexpr double BitsInByte(BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+		static constexpr double BytesInUnit(int magnitude, BytePrefix prefix = DEFAULT_PREFIX) noexcept;
+
+		static std::string BitSymbol(ByteUnit unit = ByteUnit::IEC);
+		static std::string ByteSymbol(ByteUnit unit = ByteUnit::IEC);
+		static std::string UnitSymbol(int magnitude, ByteUnit unit = ByteUnit::IEC);
+
+		constexpr BasicSize& operator+=(const BasicSize& rhs) noexcept;
+		constexpr BasicSize& operator-=(const BasicSize& rhs) noexcept;
+
+	private:
+		struct BitsTag {};
+
+		constexpr BasicSize(BitsTag, BitCount bits, BytePrefix prefix, ByteUnit unit) noexcept;
+
+		static constexpr ByteUnit DefaultUnit(BytePrefix prefix) noexcept;
+		static constexpr BytePrefix UnitPrefix(ByteUnit unit) noexcept;
+		template <typename Writer>
+		static std::errc FormatEach(const std::int64_t* counts, std::size_t size, ByteUnit unit, Writer writer);
+
+		static UnitSelection LargestUnit(BitCount bits, BytePrefix prefix, ByteUnit unit);
+
+		BitCount _bits;
+
+	};
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator==(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator!=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator<(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator<=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator>(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator>=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> operator+(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> operator-(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept;
+	template <typename Traits, typename PrefixPolicy>
+	std::ostream& operator<<(std::ostream& lhs, const BasicSize<Traits, PrefixPolicy>& rhs);
+
+}
+
+#include "BasicSize.inl"
\ No newline at end of file
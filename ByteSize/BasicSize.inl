@@ -0,0 +1,475 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+namespace hvn3 {
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy>::BasicSize(double bytes, BytePrefix prefix) noexcept :
+		BasicSize(bytes, prefix, DefaultUnit(prefix)) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy>::BasicSize(double bytes, BytePrefix prefix, ByteUnit unit) noexcept :
+		BasicSize(BitsTag(), BytesToBits(bytes), prefix, unit) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	template <typename OtherTraits, typename OtherPrefixPolicy>
+	BasicSize<Traits, PrefixPolicy>::BasicSize(const BasicSize<OtherTraits, OtherPrefixPolicy>& other) :
+		BasicSize(BitsTag(), other.ExactBits(), other.Prefix(), other.Unit()) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy>::BasicSize(BitsTag, BitCount bits, BytePrefix prefix, ByteUnit unit) noexcept :
+		PrefixPolicy(prefix, unit),
+		_bits(bits) {
+
+		assert(unit != ByteUnit::IEC || prefix == BytePrefix::Binary);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BitCount BasicSize<Traits, PrefixPolicy>::ExactBits() const noexcept {
+
+		return _bits;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BytePrefix BasicSize<Traits, PrefixPolicy>::Prefix() const noexcept {
+
+		return PrefixPolicy::Prefix();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ByteUnit BasicSize<Traits, PrefixPolicy>::Unit() const noexcept {
+
+		return PrefixPolicy::Unit();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicSize<Traits, PrefixPolicy>::Bits() const noexcept {
+
+		return static_cast<double>(_bits);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicSize<Traits, PrefixPolicy>::Bytes() const noexcept {
+
+		return Bits() / BitsInByte();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicSize<Traits, PrefixPolicy>::Units(int magnitude) const noexcept {
+
+		return Bytes() / BytesInUnit(magnitude, Prefix());
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline UnitSelection BasicSize<Traits, PrefixPolicy>::LargestUnit() const {
+
+		return LargestUnit(_bits, Prefix(), Unit());
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicSize<Traits, PrefixPolicy>::LargestUnitSymbol() const {
+
+		return LargestUnit().symbol;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	double BasicSize<Traits, PrefixPolicy>::LargestUnitValue() const {
+
+		return LargestUnit().value;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline UnitSelection BasicSize<Traits, PrefixPolicy>::LargestUnit(BitCount bits, BytePrefix prefix, ByteUnit unit) {
+
+		UnitSelection selection = SelectUnit<Traits::BITS_IN_UNIT>(bits, prefix);
+
+		selection.symbol = selection.magnitude < 0 ? BIT_SYMBOL : Traits::SYMBOLS[static_cast<int>(unit)][selection.magnitude];
+
+		return selection;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr void BasicSize<Traits, PrefixPolicy>::AddBits(double size) noexcept {
+
+		_bits = SaturatingAdd(_bits, BytesToBits(size / BitsInByte()));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr void BasicSize<Traits, PrefixPolicy>::AddBytes(double size) noexcept {
+
+		_bits = SaturatingAdd(_bits, BytesToBits(size));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr void BasicSize<Traits, PrefixPolicy>::AddUnits(int magnitude, double size) noexcept {
+
+		_bits = SaturatingAdd(_bits, BytesToBits(size * BytesInUnit(magnitude, Prefix())));
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicSize<Traits, PrefixPolicy>::ToString(unsigned int precision) const {
+
+		char buffer[64];
+		std::to_chars_result result = ToChars(buffer, buffer + sizeof(buffer), precision);
+
+		if (result.ec == std::errc())
+			return std::string(buffer, result.ptr);
+
+		// Only very large values or precisions get here, so size the buffer for the worst case.
+		std::string string(DBL_MAX_10_EXP + precision + 16, '\0');
+
+		result = ToChars(&string[0], &string[0] + string.size(), precision);
+		string.resize(result.ptr - string.data());
+
+		return string;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::to_chars_result BasicSize<Traits, PrefixPolicy>::ToChars(char* first, char* last, unsigned int precision) const {
+
+		UnitSelection unit = LargestUnit();
+
+		return FormatSize(first, last, unit.value, unit.symbol, precision);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::to_chars_result BasicSize<Traits, PrefixPolicy>::FormatMany(const std::int64_t* counts, std::size_t size, char* first, char* last, std::size_t* offsets, unsigned int precision, ByteUnit unit) {
+
+		char* it = first;
+		std::size_t index = 0;
+		std::errc error = FormatEach(counts, size, unit, [&](double value, const char* symbol) {
+
+			offsets[index++] = static_cast<std::size_t>(it - first);
+
+			std::to_chars_result result = FormatSize(it, last, value, symbol, precision);
+
+			it = result.ptr;
+
+			return result.ec;
+
+		});
+
+		if (error == std::errc())
+			offsets[size] = static_cast<std::size_t>(it - first);
+
+		return { it, error };
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::to_chars_result BasicSize<Traits, PrefixPolicy>::FormatManyFixedWidth(const std::int64_t* counts, std::size_t size, char* records, std::size_t width, unsigned int precision, ByteUnit unit) {
+
+		char* record = records;
+		std::errc error = FormatEach(counts, size, unit, [&](double value, const char* symbol) {
+
+			std::to_chars_result result = FormatSize(record, record + width, value, symbol, precision);
+
+			if (result.ec != std::errc())
+				return result.ec;
+
+			std::size_t length = static_cast<std::size_t>(result.ptr - record);
+
+			std::memmove(record + width - length, record, length);
+			std::memset(record, ' ', width - length);
+
+			record += width;
+
+			return std::errc();
+
+		});
+
+		return { record, error };
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	ColumnLayout BasicSize<Traits, PrefixPolicy>::MeasureColumn(const std::int64_t* counts, std::size_t size, unsigned int precision, ByteUnit unit) {
+
+		const PrefixPolicy policy(UnitPrefix(unit), unit);
+		std::int64_t largest = 0;
+		std::int64_t smallest = 0;
+
+		for (std::size_t i = 0; i < size; ++i) {
+
+			largest = (std::max)(largest, counts[i]);
+			smallest = (std::min)(smallest, counts[i]);
+
+		}
+
+		BitCount largest_bits = SaturatingMultiply(largest, Traits::BITS_IN_UNIT);
+		BitCount smallest_bits = SaturatingMultiply(smallest, Traits::BITS_IN_UNIT);
+		bool smallest_is_larger = UnsignedBitCount(0) - static_cast<UnsignedBitCount>(smallest_bits) > static_cast<UnsignedBitCount>(largest_bits);
+		UnitSelection selection = LargestUnit(smallest_is_larger ? smallest_bits : largest_bits, policy.Prefix(), policy.Unit());
+		ColumnLayout layout;
+
+		layout.symbol = selection.symbol;
+		layout.divisor = selection.magnitude < 0 ? 1.0 : UNIT_MULTIPLIERS[static_cast<int>(policy.Prefix())][selection.magnitude] * Traits::BITS_IN_UNIT;
+		layout.bits_in_unit = Traits::BITS_IN_UNIT;
+		layout.precision = precision;
+
+		MeasureColumnWidth(layout, largest_bits, smallest_bits);
+
+		return layout;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	void BasicSize<Traits, PrefixPolicy>::FormatColumn(const std::int64_t* counts, std::size_t size, const ColumnLayout& layout, char* records, std::size_t stride, std::size_t threadCount) {
+
+		WriteColumn(counts, size, layout, records, stride, threadCount);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	template <typename Writer>
+	std::errc BasicSize<Traits, PrefixPolicy>::FormatEach(const std::int64_t* counts, std::size_t size, ByteUnit unit, Writer writer) {
+
+		const PrefixPolicy policy(UnitPrefix(unit), unit);
+
+		for (std::size_t i = 0; i < size; ++i) {
+
+			UnitSelection selection = LargestUnit(SaturatingMultiply(counts[i], Traits::BITS_IN_UNIT), policy.Prefix(), policy.Unit());
+			std::errc error = writer(selection.value, selection.symbol);
+
+			if (error != std::errc())
+				return error;
+
+		}
+
+		return std::errc();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::MinValue() noexcept {
+
+		return BasicSize(0);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::MaxValue() noexcept {
+
+		return FromExactBits(MaxBitCount());
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::Parse(const std::string& string) {
+
+		return Parse(std::string_view(string));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::Parse(const char* string) {
+
+		return Parse(std::string_view(string));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::Parse(std::string_view string) {
+
+		BasicSize object(0);
+
+		// Throwing is not allowed during constant evaluation, so this is also what turns a malformed constexpr string into a compile error.
+		if (!TryParse(string, object))
+			throw std::invalid_argument("The input string was not in the correct format.");
+
+		return object;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	bool BasicSize<Traits, PrefixPolicy>::TryParse(const std::string& string, BasicSize& object) {
+
+		return static_cast<bool>(TryParse(std::string_view(string), object));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	bool BasicSize<Traits, PrefixPolicy>::TryParse(const char* string, BasicSize& object) {
+
+		return static_cast<bool>(TryParse(std::string_view(string), object));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ParseResult BasicSize<Traits, PrefixPolicy>::TryParse(std::string_view string, BasicSize& object) {
+
+		ParsedSize size{};
+		ParseResult result = ParseSize(string, BytesInUnit(0), size);
+
+		if (result)
+			object = size.exact ? BasicSize(BitsTag(), size.bits, size.prefix, size.unit) : BasicSize(size.bytes, size.prefix, size.unit);
+
+		return result;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	ParseManyResult BasicSize<Traits, PrefixPolicy>::ParseMany(std::string_view buffer, BitCount* counts, std::size_t countsSize, std::size_t* invalidRows, std::size_t invalidRowsSize, const ParseManyOptions& options) {
+
+		return ParseSizes(buffer, BytesInUnit(0), options, counts, countsSize, invalidRows, invalidRowsSize);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::FromExactBits(BitCount size, BytePrefix prefix) noexcept {
+
+		return BasicSize(BitsTag(), size, prefix, DefaultUnit(prefix));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::FromBits(double size, BytePrefix prefix) noexcept {
+
+		return BasicSize(size / BitsInByte(prefix), prefix);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::FromBytes(double size, BytePrefix prefix) noexcept {
+
+		return BasicSize(size, prefix);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> BasicSize<Traits, PrefixPolicy>::FromUnits(int magnitude, double size, BytePrefix prefix) noexcept {
+
+		return BasicSize(size * BytesInUnit(magnitude, prefix), prefix);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicSize<Traits, PrefixPolicy>::BitsInByte(BytePrefix) noexcept {
+
+		return 8.;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicSize<Traits, PrefixPolicy>::BytesInUnit(int magnitude, BytePrefix prefix) noexcept {
+
+		// Static prefixes ignore the argument, so the multiplier is a compile-time constant.
+		return UNIT_MULTIPLIERS[static_cast<int>(PrefixPolicy::Resolve(prefix))][magnitude] * Traits::BITS_IN_UNIT / BitsInByte();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicSize<Traits, PrefixPolicy>::BitSymbol(ByteUnit) {
+
+		return BIT_SYMBOL;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicSize<Traits, PrefixPolicy>::ByteSymbol(ByteUnit) {
+
+		return BYTE_SYMBOL;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicSize<Traits, PrefixPolicy>::UnitSymbol(int magnitude, ByteUnit unit) {
+
+		return Traits::SYMBOLS[static_cast<int>(unit)][magnitude];
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy>& BasicSize<Traits, PrefixPolicy>::operator+=(const BasicSize& rhs) noexcept {
+
+		_bits = SaturatingAdd(_bits, rhs._bits);
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy>& BasicSize<Traits, PrefixPolicy>::operator-=(const BasicSize& rhs) noexcept {
+
+		_bits = SaturatingSubtract(_bits, rhs._bits);
+
+		return *this;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ByteUnit BasicSize<Traits, PrefixPolicy>::DefaultUnit(BytePrefix prefix) noexcept {
+
+		return prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BytePrefix BasicSize<Traits, PrefixPolicy>::UnitPrefix(ByteUnit unit) noexcept {
+
+		return unit == ByteUnit::Metric ? BytePrefix::Decimal : BytePrefix::Binary;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator==(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return lhs.ExactBits() == rhs.ExactBits();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator!=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return !(lhs == rhs);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator<(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return lhs.ExactBits() < rhs.ExactBits();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator<=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return lhs.ExactBits() <= rhs.ExactBits();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator>(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return lhs.ExactBits() > rhs.ExactBits();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr bool operator>=(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		return lhs.ExactBits() >= rhs.ExactBits();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> operator+(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		BasicSize<Traits, PrefixPolicy> result(lhs);
+
+		return result += rhs;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicSize<Traits, PrefixPolicy> operator-(const BasicSize<Traits, PrefixPolicy>& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) noexcept {
+
+		BasicSize<Traits, PrefixPolicy> result(lhs);
+
+		return result -= rhs;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::ostream& operator<<(std::ostream& lhs, const BasicSize<Traits, PrefixPolicy>& rhs) {
+
+		char buffer[64];
+		std::to_chars_result result = rhs.ToChars(buffer, buffer + sizeof(buffer));
+
+		if (result.ec != std::errc())
+			return lhs << rhs.ToString();
+
+		return lhs << std::string_view(buffer, result.ptr - buffer);
+
+	}
+
+}
\ No newline at end of file
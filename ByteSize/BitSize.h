@@ -1,91 +1,173 @@
 #pragma once
-#include "ByteSizeCommon.h"
-#include <string>
+#include "BasicSize.h"
 
 namespace hvn3 {
 
-	class BitSize {
+	// Names the generic BasicSize members after bits (Kilobits(), FromMegabits(), ...).
+	template <typename Size>
+	class BitAccessors {
 
 	public:
-		BitSize(double bytes, BytePrefix prefix = BytePrefix::Binary);
-		BitSize(double bytes, BytePrefix prefix, ByteUnit unit);
-
-		double Bits() const;
-		double Bytes() const;
-
-		double Kilobits() const;
-		double Megabits() const;
-		double Gigabits() const;
-		double Terabits() const;
-		double Petabits() const;
-
-		std::string LargestUnitSymbol() const;
-		double LargestUnitValue() const;
-
-		void AddBits(double size);
-		void AddBytes(double size);
-		void AddKilobits(double size);
-		void AddMegabits(double size);
-		void AddGigabits(double size);
-		void AddTerabits(double size);
-		void AddPetabits(double size);
-
-		std::string ToString(unsigned int precision = 2) const;
-
-		static BitSize MinValue();
-		static BitSize MaxValue();
-
-		static BitSize Parse(const std::string& string);
-		static BitSize Parse(const char* string);
-		static bool TryParse(const std::string& string, BitSize& object);
-		static bool TryParse(const char* string, BitSize& object);
-
-		static BitSize FromBits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromBytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromKilobits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromMegabits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromGigabits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromTerabits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static BitSize FromPetabits(double size, BytePrefix prefix = BytePrefix::Binary);
-
-		static double BitsInByte(BytePrefix prefix = BytePrefix::Binary);
-
-		static double BytesInKilobit(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInMegabit(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInGigabit(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInTerabit(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInPetabit(BytePrefix prefix = BytePrefix::Binary);
-
-		static std::string BitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string ByteSymbol(ByteUnit unit = ByteUnit::IEC);
-
-		static std::string KilobitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string MegabitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string GigabitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string TerabitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string PetabitSymbol(ByteUnit unit = ByteUnit::IEC);
-
-		BitSize& operator+=(const BitSize& rhs);
-		BitSize& operator-=(const BitSize& rhs);
-
-		friend BitSize operator+(const BitSize& lhs, const BitSize& rhs);
-		friend BitSize operator-(const BitSize& lhs, const BitSize& rhs);
-
-	private:
-		BytePrefix _prefix;
-		ByteUnit _unit;
-		double _bytes;
+		constexpr double Kilobits() const noexcept {
+			return static_cast<const Size&>(*this).Units(1);
+		}
+		constexpr double Megabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(2);
+		}
+		constexpr double Gigabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(3);
+		}
+		constexpr double Terabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(4);
+		}
+		constexpr double Petabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(5);
+		}
+		constexpr double Exabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(6);
+		}
+		constexpr double Zettabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(7);
+		}
+		constexpr double Yottabits() const noexcept {
+			return static_cast<const Size&>(*this).Units(8);
+		}
+
+		constexpr void AddKilobits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(1, size);
+		}
+		constexpr void AddMegabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(2, size);
+		}
+		constexpr void AddGigabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(3, size);
+		}
+		constexpr void AddTerabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(4, size);
+		}
+		constexpr void AddPetabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(5, size);
+		}
+		constexpr void AddExabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(6, size);
+		}
+		constexpr void AddZettabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(7, size);
+		}
+		constexpr void AddYottabits(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(8, size);
+		}
+
+		static constexpr Size FromKilobits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(1, size, prefix);
+		}
+		static constexpr Size FromMegabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(2, size, prefix);
+		}
+		static constexpr Size FromGigabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(3, size, prefix);
+		}
+		static constexpr Size FromTerabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(4, size, prefix);
+		}
+		static constexpr Size FromPetabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(5, size, prefix);
+		}
+		static constexpr Size FromExabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(6, size, prefix);
+		}
+		static constexpr Size FromZettabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(7, size, prefix);
+		}
+		static constexpr Size FromYottabits(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(8, size, prefix);
+		}
+
+		static constexpr double BytesInKilobit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(1, prefix);
+		}
+		static constexpr double BytesInMegabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(2, prefix);
+		}
+		static constexpr double BytesInGigabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(3, prefix);
+		}
+		static constexpr double BytesInTerabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(4, prefix);
+		}
+		static constexpr double BytesInPetabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(5, prefix);
+		}
+		static constexpr double BytesInExabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(6, prefix);
+		}
+		static constexpr double BytesInZettabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(7, prefix);
+		}
+		static constexpr double BytesInYottabit(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(8, prefix);
+		}
+
+		static std::string KilobitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(1, unit);
+		}
+		static std::string MegabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(2, unit);
+		}
+		static std::string GigabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(3, unit);
+		}
+		static std::string TerabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(4, unit);
+		}
+		static std::string PetabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(5, unit);
+		}
+		static std::string ExabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(6, unit);
+		}
+		static std::string ZettabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(7, unit);
+		}
+		static std::string YottabitSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(8, unit);
+		}
 
 	};
 
-	bool operator==(const BitSize& lhs, const BitSize& rhs);
-	bool operator!=(const BitSize& lhs, const BitSize& rhs);
-	bool operator<(const BitSize& lhs, const BitSize& rhs);
-	bool operator<=(const BitSize& lhs, const BitSize& rhs);
-	bool operator>(const BitSize& lhs, const BitSize& rhs);
-	bool operator>=(const BitSize& lhs, const BitSize& rhs);
-	BitSize operator+(const BitSize& lhs, const BitSize& rhs);
-	BitSize operator-(const BitSize& lhs, const BitSize& rhs);
-	std::ostream& operator<<(std::ostream& lhs, const BitSize& rhs);
+	struct BitTraits {
+
+		template <typename Size>
+		using Accessors = BitAccessors<Size>;
+
+		static constexpr BitCount BITS_IN_UNIT = 1;
+
+		// Symbols indexed by ByteUnit, then by magnitude.
+		static constexpr const char* SYMBOLS[][MAX_MAGNITUDE + 1] = {
+			{ "b", "kbit", "Mbit", "Gbit", "Tbit", "Pbit", "Ebit", "Zbit", "Ybit" },
+			{ "b", "Kibit", "Mibit", "Gibit", "Tibit", "Pibit", "Eibit", "Zibit", "Yibit" },
+			{ "b", "Kbit", "Mbit", "Gbit", "Tbit", "Pbit", "Ebit", "Zbit", "Ybit" }
+		};
+
+	};
+
+	using BitSize = BasicSize<BitTraits>;
+	using BinaryBitSize = BasicSize<BitTraits, StaticPrefix<BytePrefix::Binary>>;
+	using DecimalBitSize = BasicSize<BitTraits, StaticPrefix<BytePrefix::Decimal>>;
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	extern template class BasicSize<BitTraits>;
+	extern template class BasicSize<BitTraits, StaticPrefix<BytePrefix::Binary>>;
+	extern template class BasicSize<BitTraits, StaticPrefix<BytePrefix::Decimal>>;
+#endif
+
+	inline namespace literals {
+		inline namespace size_literals {
+
+			// Parses a string literal such as "10 Gbit"_bits at compile time. Malformed strings fail to compile.
+			BYTESIZE_CONSTEVAL BitSize operator""_bits(const char* string, std::size_t length) { return BitSize::Parse(std::string_view(string, length)); }
+
+		}
+	}
 
 }
\ No newline at end of file
@@ -1,89 +1,173 @@
 #pragma once
-#include "ByteSizeCommon.h"
-#include <string>
+#include "BasicSize.h"
 
 namespace hvn3 {
 
-	class ByteSize {
+	// Names the generic BasicSize members after bytes (Kilobytes(), FromMegabytes(), ...).
+	template <typename Size>
+	class ByteAccessors {
 
 	public:
-		ByteSize(double bytes, BytePrefix prefix = BytePrefix::Binary);
-		ByteSize(double bytes, BytePrefix prefix, ByteUnit unit);
-
-		double Bits() const;
-		double Bytes() const;
-
-		double Kilobytes() const;
-		double Megabytes() const;
-		double Gigabytes() const;
-		double Terabytes() const;
-		double Petabytes() const;
-
-		std::string LargestUnitSymbol() const;
-		double LargestUnitValue() const;
-
-		void AddBits(double size);
-		void AddBytes(double size);
-		void AddKilobytes(double size);
-		void AddMegabytes(double size);
-		void AddGigabytes(double size);
-		void AddTerabytes(double size);
-		void AddPetabytes(double size);
-
-		std::string ToString(unsigned int precision = 2) const;
-
-		static ByteSize MinValue();
-		static ByteSize MaxValue();
-
-		static ByteSize Parse(const std::string& string);
-		static ByteSize Parse(const char* string);
-		static bool TryParse(const std::string& string, ByteSize& object);
-		static bool TryParse(const char* string, ByteSize& object);
-
-		static ByteSize FromBits(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromBytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromKilobytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromMegabytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromGigabytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromTerabytes(double size, BytePrefix prefix = BytePrefix::Binary);
-		static ByteSize FromPetabytes(double size, BytePrefix prefix = BytePrefix::Binary);
-
-		static double BitsInByte(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInKilobyte(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInMegabyte(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInGigabyte(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInTerabyte(BytePrefix prefix = BytePrefix::Binary);
-		static double BytesInPetabyte(BytePrefix prefix = BytePrefix::Binary);
-
-		static std::string BitSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string ByteSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string KilobyteSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string MegabyteSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string GigabyteSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string TerabyteSymbol(ByteUnit unit = ByteUnit::IEC);
-		static std::string PetabyteSymbol(ByteUnit unit = ByteUnit::IEC);
-
-		ByteSize& operator+=(const ByteSize& rhs);
-		ByteSize& operator-=(const ByteSize& rhs);
-
-		friend ByteSize operator+(const ByteSize& lhs, const ByteSize& rhs);
-		friend ByteSize operator-(const ByteSize& lhs, const ByteSize& rhs);
-
-	private:
-		BytePrefix _prefix;
-		ByteUnit _unit;
-		double _bytes;
+		constexpr double Kilobytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(1);
+		}
+		constexpr double Megabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(2);
+		}
+		constexpr double Gigabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(3);
+		}
+		constexpr double Terabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(4);
+		}
+		constexpr double Petabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(5);
+		}
+		constexpr double Exabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(6);
+		}
+		constexpr double Zettabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(7);
+		}
+		constexpr double Yottabytes() const noexcept {
+			return static_cast<const Size&>(*this).Units(8);
+		}
+
+		constexpr void AddKilobytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(1, size);
+		}
+		constexpr void AddMegabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(2, size);
+		}
+		constexpr void AddGigabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(3, size);
+		}
+		constexpr void AddTerabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(4, size);
+		}
+		constexpr void AddPetabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(5, size);
+		}
+		constexpr void AddExabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(6, size);
+		}
+		constexpr void AddZettabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(7, size);
+		}
+		constexpr void AddYottabytes(double size) noexcept {
+			static_cast<Size&>(*this).AddUnits(8, size);
+		}
+
+		static constexpr Size FromKilobytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(1, size, prefix);
+		}
+		static constexpr Size FromMegabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(2, size, prefix);
+		}
+		static constexpr Size FromGigabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(3, size, prefix);
+		}
+		static constexpr Size FromTerabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(4, size, prefix);
+		}
+		static constexpr Size FromPetabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(5, size, prefix);
+		}
+		static constexpr Size FromExabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(6, size, prefix);
+		}
+		static constexpr Size FromZettabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(7, size, prefix);
+		}
+		static constexpr Size FromYottabytes(double size, BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::FromUnits(8, size, prefix);
+		}
+
+		static constexpr double BytesInKilobyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(1, prefix);
+		}
+		static constexpr double BytesInMegabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(2, prefix);
+		}
+		static constexpr double BytesInGigabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(3, prefix);
+		}
+		static constexpr double BytesInTerabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(4, prefix);
+		}
+		static constexpr double BytesInPetabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(5, prefix);
+		}
+		static constexpr double BytesInExabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(6, prefix);
+		}
+		static constexpr double BytesInZettabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(7, prefix);
+		}
+		static constexpr double BytesInYottabyte(BytePrefix prefix = Size::DEFAULT_PREFIX) noexcept {
+			return Size::BytesInUnit(8, prefix);
+		}
+
+		static std::string KilobyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(1, unit);
+		}
+		static std::string MegabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(2, unit);
+		}
+		static std::string GigabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(3, unit);
+		}
+		static std::string TerabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(4, unit);
+		}
+		static std::string PetabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(5, unit);
+		}
+		static std::string ExabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(6, unit);
+		}
+		static std::string ZettabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(7, unit);
+		}
+		static std::string YottabyteSymbol(ByteUnit unit = ByteUnit::IEC) {
+			return Size::UnitSymbol(8, unit);
+		}
 
 	};
 
-	bool operator==(const ByteSize& lhs, const ByteSize& rhs);
-	bool operator!=(const ByteSize& lhs, const ByteSize& rhs);
-	bool operator<(const ByteSize& lhs, const ByteSize& rhs);
-	bool operator<=(const ByteSize& lhs, const ByteSize& rhs);
-	bool operator>(const ByteSize& lhs, const ByteSize& rhs);
-	bool operator>=(const ByteSize& lhs, const ByteSize& rhs);
-	ByteSize operator+(const ByteSize& lhs, const ByteSize& rhs);
-	ByteSize operator-(const ByteSize& lhs, const ByteSize& rhs);
-	std::ostream& operator<<(std::ostream& lhs, const ByteSize& rhs);
+	struct ByteTraits {
+
+		template <typename Size>
+		using Accessors = ByteAccessors<Size>;
+
+		static constexpr BitCount BITS_IN_UNIT = 8;
+
+		// Symbols indexed by ByteUnit, then by magnitude.
+		static constexpr const char* SYMBOLS[][MAX_MAGNITUDE + 1] = {
+			{ "B", "kB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB" },
+			{ "B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB" },
+			{ "B", "KB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB" }
+		};
+
+	};
+
+	using ByteSize = BasicSize<ByteTraits>;
+	using BinaryByteSize = BasicSize<ByteTraits, StaticPrefix<BytePrefix::Binary>>;
+	using DecimalByteSize = BasicSize<ByteTraits, StaticPrefix<BytePrefix::Decimal>>;
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	extern template class BasicSize<ByteTraits>;
+	extern template class BasicSize<ByteTraits, StaticPrefix<BytePrefix::Binary>>;
+	extern template class BasicSize<ByteTraits, StaticPrefix<BytePrefix::Decimal>>;
+#endif
+
+	inline namespace literals {
+		inline namespace size_literals {
+
+			// Parses a string literal such as "1.5 GiB"_bytes at compile time. Malformed strings fail to compile.
+			BYTESIZE_CONSTEVAL ByteSize operator""_bytes(const char* string, std::size_t length) { return ByteSize::Parse(std::string_view(string, length)); }
+
+		}
+	}
 
 }
\ No newline at end of file
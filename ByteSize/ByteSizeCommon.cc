@@ -1,21 +1,381 @@
 #include "ByteSizeCommon.h"
 #include <algorithm>
-#define BYTES_IN_BIT 0.125
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace hvn3 {
 
-	double RoundBytesToNearestBit(double bytes) {
+	static const double BYTES_IN_BIT = 0.125;
 
-		double remainder = (std::fmod)(bytes, BYTES_IN_BIT);
+	static const std::uint64_t POWERS_OF_TEN[] = {
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+		100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+		100000000000000000ull, 1000000000000000000ull
+	};
+	// UINT64_MAX / POWERS_OF_TEN[i], so that checking whether a value can be scaled doesn't need a division.
+	static const std::uint64_t MAX_SCALABLE[] = {
+		18446744073709551615ull, 1844674407370955161ull, 184467440737095516ull, 18446744073709551ull, 1844674407370955ull, 184467440737095ull,
+		18446744073709ull, 1844674407370ull, 184467440737ull, 18446744073ull, 1844674407ull, 184467440ull, 18446744ull, 1844674ull, 184467ull,
+		18446ull, 1844ull, 184ull, 18ull
+	};
+	static const char DIGIT_PAIRS[] =
+		"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+		"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
 
-		bytes -= remainder;
+	static int CountTrailingZeros(std::uint64_t value) {
 
-		if (remainder > 0.0)
-			bytes += BYTES_IN_BIT;
-		else if (remainder < 0.0)
-			bytes -= BYTES_IN_BIT;
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(value);
+#else
+		int count = 0;
 
-		return bytes;
+		for (; (value & 1) == 0; value >>= 1)
+			++count;
+
+		return count;
+#endif
+
+	}
+	// Writes the digits of value so that they end at last, and returns a pointer to the first digit.
+	static char* WriteDigitsBackward(std::uint64_t value, char* last) {
+
+		while (value >= 100) {
+
+			const char* pair = DIGIT_PAIRS + (value % 100) * 2;
+
+			value /= 100;
+			*--last = pair[1];
+			*--last = pair[0];
+
+		}
+
+		if (value >= 10) {
+
+			*--last = DIGIT_PAIRS[value * 2 + 1];
+			*--last = DIGIT_PAIRS[value * 2];
+
+		}
+		else
+			*--last = static_cast<char>('0' + value);
+
+		return last;
+
+	}
+	// Computes the magnitude of value * 10^precision, rounded with the same rounding as std::to_chars, using only 64-bit integer arithmetic.
+	// A double is mantissa * 2^exponent, so value * 10^precision can be computed and rounded (half to even) exactly as long as it fits.
+	// Returns false if it does not, which only happens for very large values or precisions.
+	static bool ScaleFixed(double value, unsigned int precision, std::uint64_t& scaled, bool& negative) {
+
+		if (precision >= sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]) || !std::isfinite(value))
+			return false;
+
+		std::uint64_t representation;
+		std::memcpy(&representation, &value, sizeof(representation));
+
+		negative = (representation >> 63) != 0;
+		int biased_exponent = static_cast<int>((representation >> 52) & 0x7FF);
+		std::uint64_t mantissa = representation & ((std::uint64_t(1) << 52) - 1);
+		int exponent = biased_exponent == 0 ? -1074 : biased_exponent - 1075;
+
+		if (biased_exponent != 0)
+			mantissa |= std::uint64_t(1) << 52;
+
+		if (mantissa == 0)
+			exponent = 0;
+		else {
+
+			int zeros = CountTrailingZeros(mantissa);
+
+			mantissa >>= zeros;
+			exponent += zeros;
+
+		}
+
+		std::uint64_t scale = POWERS_OF_TEN[precision];
+
+		if (mantissa > MAX_SCALABLE[precision])
+			return false;
+
+		scaled = mantissa * scale;
+
+		if (exponent >= 0) {
+
+			if (exponent >= 64 || scaled > (UINT64_MAX >> exponent))
+				return false;
+
+			scaled <<= exponent;
+
+		}
+		else {
+
+			if (exponent <= -64)
+				return false;
+
+			int shift = -exponent;
+			std::uint64_t remainder = scaled & ((std::uint64_t(1) << shift) - 1);
+			std::uint64_t half = std::uint64_t(1) << (shift - 1);
+
+			scaled >>= shift;
+
+			if (remainder > half || (remainder == half && (scaled & 1) != 0))
+				++scaled;
+
+		}
+
+		return true;
+
+	}
+	// Writes value in fixed notation with the same rounding as std::to_chars. Returns false without writing anything if ScaleFixed fails.
+	static bool FormatFixed(char* first, char* last, double value, unsigned int precision, std::to_chars_result& result) {
+
+		std::uint64_t scaled;
+		bool negative;
+
+		if (!ScaleFixed(value, precision, scaled, negative))
+			return false;
+
+		std::uint64_t scale = POWERS_OF_TEN[precision];
+		std::uint64_t integer = scaled / scale;
+		char digits[24];
+		char* digits_last = digits + sizeof(digits);
+		char* digits_first = WriteDigitsBackward(integer, digits_last);
+		std::size_t integer_length = static_cast<std::size_t>(digits_last - digits_first);
+		std::size_t length = negative + integer_length + (precision > 0 ? precision + 1 : 0);
+
+		if (static_cast<std::size_t>(last - first) < length) {
+
+			result = { last, std::errc::value_too_large };
+
+			return true;
+
+		}
+
+		if (negative)
+			*first++ = '-';
+
+		first = std::copy(digits_first, digits_last, first);
+
+		if (precision > 0) {
+
+			*first++ = '.';
+
+			// Pad the fraction with leading zeros by writing it one past a leading 1 (e.g. 5 with a precision of 3 becomes "1005").
+			digits_first = WriteDigitsBackward(scale + (scaled - integer * scale), digits_last);
+			first = std::copy(digits_first + 1, digits_last, first);
+
+		}
+
+		result = { first, std::errc() };
+
+		return true;
+
+	}
+
+	BYTESIZE_INLINE void MeasureColumnWidth(ColumnLayout& layout, BitCount largest, BitCount smallest) {
+
+		std::size_t width = 0;
+
+		// Formatted lengths only grow with the magnitude of the value, so the largest and smallest counts give the longest string.
+		for (BitCount bits : { largest, smallest }) {
+
+			double value = static_cast<double>(bits) / layout.divisor;
+			std::uint64_t scaled;
+			bool negative;
+			std::size_t length;
+
+			if (ScaleFixed(value, layout.precision, scaled, negative)) {
+
+				char digits[24];
+
+				length = negative + static_cast<std::size_t>(digits + sizeof(digits) - WriteDigitsBackward(scaled / POWERS_OF_TEN[layout.precision], digits + sizeof(digits))) + (layout.precision > 0 ? layout.precision + 1 : 0);
+
+			}
+			else {
+
+				std::string string(DBL_MAX_10_EXP + layout.precision + 16, '\0');
+
+				length = static_cast<std::size_t>(std::to_chars(&string[0], &string[0] + string.size(), value, std::chars_format::fixed, static_cast<int>((std::min)(layout.precision, static_cast<unsigned int>(INT_MAX)))).ptr - string.data());
+
+			}
+
+			width = (std::max)(width, length);
+
+		}
+
+		layout.width = width + 1 + std::strlen(layout.symbol);
+
+	}
+	static void WriteColumnRange(const std::int64_t* counts, std::size_t size, const ColumnLayout& layout, char* records, std::size_t stride) {
+
+		std::size_t symbol_length = std::strlen(layout.symbol);
+		// The same saturation as SaturatingMultiply, with the divisions done once rather than for every count.
+		BitCount max_count = MaxBitCount() / layout.bits_in_unit;
+		BitCount min_count = MinBitCount() / layout.bits_in_unit;
+
+		for (std::size_t i = 0; i < size; ++i) {
+
+			char* record = records + i * stride;
+			BitCount bits = counts[i] > max_count ? MaxBitCount() : counts[i] < min_count ? MinBitCount() : counts[i] * layout.bits_in_unit;
+			double value = static_cast<double>(bits) / layout.divisor;
+			std::uint64_t scaled;
+			bool negative;
+
+			if (!ScaleFixed(value, layout.precision, scaled, negative)) {
+
+				// Only very large values or precisions get here. MeasureColumnWidth made room for them.
+				std::to_chars_result result = FormatSize(record, record + layout.width, value, layout.symbol, layout.precision);
+				std::size_t length = static_cast<std::size_t>(result.ptr - record);
+
+				std::memmove(record + layout.width - length, record, length);
+				std::memset(record, ' ', layout.width - length);
+
+				continue;
+
+			}
+
+			// The record is written backward from its end, so that it is aligned without being measured first.
+			char* it = record + layout.width - symbol_length;
+
+			std::memcpy(it, layout.symbol, symbol_length);
+			*--it = ' ';
+
+			// The fraction is peeled off two digits at a time, since dividing by a constant is much faster than by 10^precision.
+			unsigned int fraction_digits = layout.precision;
+
+			for (; fraction_digits >= 2; fraction_digits -= 2) {
+
+				const char* pair = DIGIT_PAIRS + (scaled % 100) * 2;
+
+				scaled /= 100;
+				*--it = pair[1];
+				*--it = pair[0];
+
+			}
+
+			if (fraction_digits == 1) {
+
+				*--it = static_cast<char>('0' + scaled % 10);
+				scaled /= 10;
+
+			}
+
+			if (layout.precision > 0)
+				*--it = '.';
+
+			it = WriteDigitsBackward(scaled, it);
+
+			if (negative)
+				*--it = '-';
+
+			std::memset(record, ' ', static_cast<std::size_t>(it - record));
+
+		}
+
+	}
+
+	BYTESIZE_INLINE void WriteColumn(const std::int64_t* counts, std::size_t size, const ColumnLayout& layout, char* records, std::size_t stride, std::size_t threadCount) {
+
+		// Each thread writes its own rows, which don't overlap, so the threads only need to be joined.
+		const std::size_t min_rows_per_thread = std::size_t(1) << 16;
+		std::size_t thread_count = (std::min)(threadCount == 0 ? HardwareConcurrency() : threadCount, (std::max)(std::size_t(1), size / min_rows_per_thread));
+		std::size_t chunk_size = (size + thread_count - 1) / thread_count;
+		std::vector<std::thread> threads;
+
+		threads.reserve(thread_count - 1);
+
+		for (std::size_t i = 1; i < thread_count; ++i) {
+
+			std::size_t first = (std::min)(size, i * chunk_size);
+			std::size_t count = (std::min)(size - first, chunk_size);
+
+			threads.emplace_back([=, &layout] {
+				WriteColumnRange(counts + first, count, layout, records + first * stride, stride);
+			});
+
+		}
+
+		WriteColumnRange(counts, (std::min)(size, chunk_size), layout, records, stride);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+	}
+
+	BYTESIZE_INLINE double RoundBytesToNearestBit(double bytes) {
+
+		// Scaling by a power of two is exact, so this rounds away from zero without needing fmod.
+		double bits = bytes / BYTES_IN_BIT;
+
+		return (bits < 0.0 ? (std::floor)(bits) : (std::ceil)(bits)) * BYTES_IN_BIT;
+
+	}
+	BYTESIZE_INLINE void RoundBytesToNearestBit(const double* bytes, std::size_t size, double* rounded) {
+
+		// Rounding the magnitude up and restoring the sign rounds away from zero with no comparisons.
+		for (std::size_t i = 0; i < size; ++i) {
+
+			double bits = bytes[i] / BYTES_IN_BIT;
+
+			rounded[i] = std::copysign(std::ceil(std::fabs(bits)), bits) * BYTES_IN_BIT;
+
+		}
+
+	}
+	BYTESIZE_INLINE void BytesToBits(const double* bytes, std::size_t size, BitCount* bits) {
+
+		// The largest double below MaxBitCount(), which is a power of two, so that clamped values can always be converted.
+		const double max_convertible = static_cast<double>(MaxBitCount()) * (1.0 - DBL_EPSILON / 2);
+		const double min_convertible = static_cast<double>(MinBitCount());
+
+		for (std::size_t i = 0; i < size; ++i) {
+
+			double value = bytes[i] * 8.0;
+
+			value = value == value ? value : 0.0;
+			value = std::copysign(std::ceil(std::fabs(value)), value);
+
+			BitCount count = static_cast<BitCount>((std::max)(min_convertible, (std::min)(max_convertible, value)));
+
+			bits[i] = value >= static_cast<double>(MaxBitCount()) ? MaxBitCount() : count;
+
+		}
+
+	}
+
+	BYTESIZE_INLINE std::size_t HardwareConcurrency() {
+
+		unsigned int count = std::thread::hardware_concurrency();
+
+		return count == 0 ? 1 : count;
+
+	}
+
+	BYTESIZE_INLINE std::to_chars_result FormatSize(char* first, char* last, double value, const char* symbol, unsigned int precision) {
+
+		std::to_chars_result result;
+
+		if (!FormatFixed(first, last, value, precision, result))
+			result = std::to_chars(first, last, value, std::chars_format::fixed, static_cast<int>((std::min)(precision, static_cast<unsigned int>(INT_MAX))));
+
+		if (result.ec != std::errc())
+			return result;
+
+		std::size_t length = std::strlen(symbol);
+
+		if (static_cast<std::size_t>(last - result.ptr) < length + 1)
+			return { last, std::errc::value_too_large };
+
+		*result.ptr++ = ' ';
+		result.ptr = std::copy(symbol, symbol + length, result.ptr);
+
+		return result;
 
 	}
 
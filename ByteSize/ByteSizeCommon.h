@@ -1,4 +1,24 @@
 #pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// String literals such as "1.5 GiB"_bytes are parsed by the compiler where consteval is available, and otherwise may be.
+#if defined(__cpp_consteval)
+#define BYTESIZE_CONSTEVAL consteval
+#else
+#define BYTESIZE_CONSTEVAL constexpr
+#endif
+
+// Define BYTESIZE_HEADER_ONLY to use the library without building it: each header then includes the definitions from its .cc file, marked
+// inline, and templates are instantiated where they are used instead of in the library, so every call can be inlined without LTO.
+// The .cc files must not be compiled separately in this mode.
+#if defined(BYTESIZE_HEADER_ONLY)
+#define BYTESIZE_INLINE inline
+#else
+#define BYTESIZE_INLINE
+#endif
 
 namespace hvn3 {
 
@@ -15,6 +35,221 @@ namespace hvn3 {
 		JEDEC
 	};
 
+	constexpr const char* BIT_SYMBOL = "b";
+	constexpr const char* BYTE_SYMBOL = "B";
+
+	// Magnitudes are numbered from the base unit (0) up to yotta (8).
+	constexpr int MAX_MAGNITUDE = 8;
+
+	// Number of base units in one unit of each magnitude, indexed by BytePrefix and then by magnitude.
+	inline constexpr double UNIT_MULTIPLIERS[][MAX_MAGNITUDE + 1] = {
+		{ 1., 1e3, 1e6, 1e9, 1e12, 1e15, 1e18, 1e21, 1e24 },
+		{ 1., 1024., 1048576., 1073741824., 1099511627776., 1125899906842624., 1152921504606846976., 1180591620717411303424., 1208925819614629174706176. }
+	};
+
+#if defined(BYTESIZE_INT128) && defined(__SIZEOF_INT128__)
+	// 128-bit counts cover the exa- and zetta- ranges, at the cost of doubling the size of each object.
+	typedef __int128 BitCount;
+	typedef unsigned __int128 UnsignedBitCount;
+#else
+	// 64-bit counts are exact up to just under one exbibyte.
+	typedef std::int64_t BitCount;
+	typedef std::uint64_t UnsignedBitCount;
+#endif
+
+	constexpr BitCount MaxBitCount() {
+		return static_cast<BitCount>(~UnsignedBitCount(0) >> 1);
+	}
+	constexpr BitCount MinBitCount() {
+		return -MaxBitCount() - 1;
+	}
+
+	// Returns true when called during constant evaluation, so constexpr code can avoid runtime-only functions like std::from_chars.
+	constexpr bool IsConstantEvaluated() {
+#if defined(__cpp_lib_is_constant_evaluated)
+		return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+		return __builtin_is_constant_evaluated();
+#else
+		return false;
+#endif
+	}
+
+	// Adds or subtracts bit counts, saturating at MinBitCount() and MaxBitCount() instead of overflowing.
+	constexpr BitCount SaturatingAdd(BitCount lhs, BitCount rhs) {
+#if defined(__GNUC__) || defined(__clang__)
+		BitCount result = 0;
+		if (__builtin_add_overflow(lhs, rhs, &result))
+			return rhs < 0 ? MinBitCount() : MaxBitCount();
+		return result;
+#else
+		if (rhs > 0 && lhs > MaxBitCount() - rhs)
+			return MaxBitCount();
+		if (rhs < 0 && lhs < MinBitCount() - rhs)
+			return MinBitCount();
+		return lhs + rhs;
+#endif
+	}
+	constexpr BitCount SaturatingSubtract(BitCount lhs, BitCount rhs) {
+#if defined(__GNUC__) || defined(__clang__)
+		BitCount result = 0;
+		if (__builtin_sub_overflow(lhs, rhs, &result))
+			return rhs > 0 ? MinBitCount() : MaxBitCount();
+		return result;
+#else
+		if (rhs < 0 && lhs > MaxBitCount() + rhs)
+			return MaxBitCount();
+		if (rhs > 0 && lhs < MinBitCount() + rhs)
+			return MinBitCount();
+		return lhs - rhs;
+#endif
+	}
+
+	// Multiplies a bit count by a non-negative factor, saturating instead of overflowing.
+	constexpr BitCount SaturatingMultiply(BitCount lhs, BitCount rhs) {
+		if (rhs != 0 && lhs > MaxBitCount() / rhs)
+			return MaxBitCount();
+		if (rhs != 0 && lhs < MinBitCount() / rhs)
+			return MinBitCount();
+		return lhs * rhs;
+	}
+
+	// Converts a number of bytes to bits, rounding partial bits away from zero like RoundBytesToNearestBit.
+	// Values outside of the representable range saturate, and NaN becomes zero.
+	constexpr BitCount BytesToBits(double bytes) {
+
+		double bits = bytes * 8.0;
+
+		if (!(bits == bits))
+			return 0;
+		if (bits >= static_cast<double>(MaxBitCount()))
+			return MaxBitCount();
+		if (bits <= static_cast<double>(MinBitCount()))
+			return MinBitCount();
+
+		BitCount truncated = static_cast<BitCount>(bits);
+
+		return truncated + (bits > static_cast<double>(truncated)) - (bits < static_cast<double>(truncated));
+
+	}
+	// Converts a whole number of bytes to bits exactly, saturating if the result is not representable.
+	template <typename IntegerType, typename std::enable_if<std::is_integral<IntegerType>::value, int>::type = 0>
+	constexpr BitCount BytesToBits(IntegerType bytes) {
+
+		if constexpr (std::is_signed<IntegerType>::value) {
+			if (bytes < 0)
+				return bytes < MinBitCount() / 8 ? MinBitCount() : static_cast<BitCount>(bytes) * 8;
+		}
+
+		if (static_cast<typename std::make_unsigned<IntegerType>::type>(bytes) > static_cast<UnsignedBitCount>(MaxBitCount() / 8))
+			return MaxBitCount();
+
+		return static_cast<BitCount>(bytes) * 8;
+
+	}
+
+	// Number of base units in one decimal unit of each magnitude as an integer. Units past the range of BitCount are never reached.
+	inline constexpr UnsignedBitCount DECIMAL_UNIT_COUNTS[MAX_MAGNITUDE + 1] = {
+		1, 1000, 1000000, 1000000000, 1000000000000, 1000000000000000, 1000000000000000000,
+#if defined(BYTESIZE_INT128) && defined(__SIZEOF_INT128__)
+		UnsignedBitCount(1000000000000000000) * 1000, UnsignedBitCount(1000000000000000000) * 1000000
+#else
+		~UnsignedBitCount(0), ~UnsignedBitCount(0)
+#endif
+	};
+
+	// Returns the index of the highest set bit of a non-zero value.
+	constexpr int HighestSetBit(UnsignedBitCount value) {
+#if defined(BYTESIZE_INT128) && defined(__SIZEOF_INT128__)
+		std::uint64_t high = static_cast<std::uint64_t>(value >> 64);
+		return high != 0 ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll(static_cast<std::uint64_t>(value));
+#elif defined(__GNUC__) || defined(__clang__)
+		return 63 - __builtin_clzll(value);
+#else
+		int bit = 0;
+		for (int shift = 32; shift > 0; shift /= 2)
+			if ((value >> shift) != 0) {
+				value >>= shift;
+				bit += shift;
+			}
+		return bit;
+#endif
+	}
+
+	struct UnitSelection {
+		// Magnitude of the largest unit in which the value is at least one, or -1 if the value is less than one base unit and is shown in bits.
+		int magnitude;
+		// The value in that unit.
+		double value;
+		// Symbol of that unit. Left empty by SelectUnit, which does not know the unit names.
+		const char* symbol;
+	};
+
+	// Selects the largest unit in which bits (counted in units of BitsInUnit bits) is at least one, without trying each unit in turn.
+	// Binary units are 2^10 apart, so the magnitude comes straight from the position of the highest set bit. Decimal units are estimated
+	// the same way (2^10 is close to 1000) and corrected with a single comparison.
+	template <BitCount BitsInUnit>
+	constexpr UnitSelection SelectUnit(BitCount bits, BytePrefix prefix) {
+
+		UnsignedBitCount units = (bits < 0 ? UnsignedBitCount(0) - static_cast<UnsignedBitCount>(bits) : static_cast<UnsignedBitCount>(bits)) / BitsInUnit;
+
+		if (units == 0)
+			return { -1, static_cast<double>(bits), nullptr };
+
+		int highest_bit = HighestSetBit(units);
+		int magnitude;
+
+		if (prefix == BytePrefix::Binary)
+			magnitude = highest_bit / 10;
+		else {
+
+			// 1233 / 4096 is just under log10(2), so this is the number of decimal digits in units minus one, or one less than that.
+			magnitude = (highest_bit * 1233 >> 12) / 3;
+
+			if (magnitude < MAX_MAGNITUDE && units >= DECIMAL_UNIT_COUNTS[magnitude + 1])
+				++magnitude;
+
+		}
+
+		if (magnitude > MAX_MAGNITUDE)
+			magnitude = MAX_MAGNITUDE;
+
+		return { magnitude, static_cast<double>(bits) / (UNIT_MULTIPLIERS[static_cast<int>(prefix)][magnitude] * BitsInUnit), nullptr };
+
+	}
+
+	// A column of sizes that share one unit and are right-aligned to one width, as chosen by MeasureColumn.
+	struct ColumnLayout {
+		// Symbol of the shared unit.
+		const char* symbol;
+		// Each count is converted to bits (counted in units of bits_in_unit bits) and divided by this to get its value in the shared unit.
+		double divisor;
+		BitCount bits_in_unit;
+		unsigned int precision;
+		// The length of the longest formatted count, including the unit. It may be increased to pad every record further, but not reduced.
+		std::size_t width;
+	};
+
+	// Sets layout.width to the length of the longer of the two counts formatted in the layout's unit. The other fields must be set.
+	void MeasureColumnWidth(ColumnLayout& layout, BitCount largest, BitCount smallest);
+	// Writes "<value> <symbol>" for each count into records + i * stride, right-aligned in layout.width characters and padded with spaces.
+	// threadCount threads share the work on large columns; zero uses one per hardware thread.
+	void WriteColumn(const std::int64_t* counts, std::size_t size, const ColumnLayout& layout, char* records, std::size_t stride, std::size_t threadCount);
+
 	double RoundBytesToNearestBit(double bytes);
+	// Same as calling RoundBytesToNearestBit and BytesToBits on each element, but written without branches so that compilers can vectorize it.
+	void RoundBytesToNearestBit(const double* bytes, std::size_t size, double* rounded);
+	void BytesToBits(const double* bytes, std::size_t size, BitCount* bits);
+
+	// Returns the number of hardware threads, or 1 if it is unknown.
+	std::size_t HardwareConcurrency();
+
+	// Writes "<value> <symbol>" into [first, last) using fixed notation with the given number of digits after the decimal point.
+	// Nothing is allocated and the current locale is ignored. If the buffer is too small, ec is set to std::errc::value_too_large.
+	std::to_chars_result FormatSize(char* first, char* last, double value, const char* symbol, unsigned int precision);
+
+}
 
-}
\ No newline at end of file
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "ByteSizeCommon.cc"
+#endif
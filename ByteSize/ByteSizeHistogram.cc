@@ -0,0 +1,204 @@
+#include "ByteSizeHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace hvn3 {
+
+	static const std::uint64_t BUCKET_POWERS_OF_TEN[] = {
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+		100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+		100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+	};
+
+	// Returns floor(log10(value)) for a non-zero value, estimated from the highest set bit and corrected with one comparison.
+	static int DecimalExponent(std::uint64_t value) {
+
+		int exponent = HighestSetBit(value) * 1233 >> 12;
+
+		return value >= BUCKET_POWERS_OF_TEN[exponent + 1] ? exponent + 1 : exponent;
+
+	}
+
+	BYTESIZE_INLINE ByteSizeHistogram::ByteSizeHistogram(BytePrefix prefix) :
+		_prefix(prefix) {
+
+		Reset();
+
+	}
+
+	BYTESIZE_INLINE BytePrefix ByteSizeHistogram::Prefix() const {
+
+		return _prefix;
+
+	}
+
+	BYTESIZE_INLINE void ByteSizeHistogram::Record(const ByteSize& size) {
+
+		Record(size, 1);
+
+	}
+	BYTESIZE_INLINE void ByteSizeHistogram::Record(const ByteSize& size, std::uint64_t count) {
+
+		BitCount bits = size.ExactBits();
+		std::uint64_t bytes = bits <= 0 ? 0 : static_cast<UnsignedBitCount>(bits / 8) > UINT64_MAX ? UINT64_MAX : static_cast<std::uint64_t>(bits / 8);
+
+		_buckets[BucketIndex(bytes, _prefix)] += count;
+		_count += count;
+		_sum_bits = SaturatingAdd(_sum_bits, SaturatingMultiply(BytesToBits(bytes), static_cast<BitCount>(count)));
+		_min = (std::min)(_min, bytes);
+		_max = (std::max)(_max, bytes);
+
+	}
+	BYTESIZE_INLINE void ByteSizeHistogram::Merge(const ByteSizeHistogram& other) {
+
+		if (other._prefix != _prefix)
+			throw std::invalid_argument("Histograms with different prefixes cannot be merged.");
+
+		for (std::size_t i = 0; i < BucketCount(_prefix); ++i)
+			_buckets[i] += other._buckets[i];
+
+		_count += other._count;
+		_sum_bits = SaturatingAdd(_sum_bits, other._sum_bits);
+		_min = (std::min)(_min, other._min);
+		_max = (std::max)(_max, other._max);
+
+	}
+	BYTESIZE_INLINE void ByteSizeHistogram::Reset() {
+
+		_count = 0;
+		_sum_bits = 0;
+		_min = UINT64_MAX;
+		_max = 0;
+		_buckets.fill(0);
+
+	}
+
+	BYTESIZE_INLINE std::uint64_t ByteSizeHistogram::Count() const {
+
+		return _count;
+
+	}
+	BYTESIZE_INLINE std::uint64_t ByteSizeHistogram::CountInBucket(std::size_t index) const {
+
+		return _buckets[index];
+
+	}
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Sum() const {
+
+		return ByteSize::FromExactBits(_sum_bits, _prefix);
+
+	}
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Mean() const {
+
+		return ByteSize::FromBits(_count == 0 ? 0.0 : static_cast<double>(_sum_bits) / static_cast<double>(_count), _prefix);
+
+	}
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Min() const {
+
+		return FromBytes(_count == 0 ? 0 : _min);
+
+	}
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Max() const {
+
+		return FromBytes(_max);
+
+	}
+
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Percentile(double percentile) const {
+
+		if (_count == 0)
+			return FromBytes(0);
+
+		// The rank of the requested size among the recorded sizes, counting from one.
+		double rank = std::ceil((std::min)((std::max)(percentile, 0.0), 100.0) / 100.0 * static_cast<double>(_count));
+		std::uint64_t target = rank < 1.0 ? 1 : static_cast<std::uint64_t>(rank);
+		std::uint64_t seen = 0;
+
+		for (std::size_t i = 0; i < BucketCount(_prefix); ++i) {
+
+			seen += _buckets[i];
+
+			if (seen >= target)
+				return FromBytes((std::max)(_min, (std::min)(_max, BucketUpperBound(i, _prefix))));
+
+		}
+
+		return FromBytes(_max);
+
+	}
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::Quantile(double quantile) const {
+
+		return Percentile(quantile * 100.0);
+
+	}
+
+	BYTESIZE_INLINE std::string ByteSizeHistogram::ToString(unsigned int precision) const {
+
+		std::string string = "count " + std::to_string(_count);
+
+		string += ", p50 " + Percentile(50.0).ToString(precision);
+		string += ", p99 " + Percentile(99.0).ToString(precision);
+		string += ", p99.9 " + Percentile(99.9).ToString(precision);
+		string += ", max " + Max().ToString(precision);
+
+		return string;
+
+	}
+
+	BYTESIZE_INLINE std::size_t ByteSizeHistogram::BucketIndex(std::uint64_t bytes, BytePrefix prefix) {
+
+		if (prefix == BytePrefix::Binary) {
+
+			if (bytes < 32)
+				return static_cast<std::size_t>(bytes);
+
+			// The five bits after the highest set bit select one of 32 buckets within its power of two.
+			int shift = HighestSetBit(bytes) - 5;
+
+			return 32 + static_cast<std::size_t>(shift) * 32 + static_cast<std::size_t>((bytes >> shift) - 32);
+
+		}
+
+		if (bytes < 100)
+			return static_cast<std::size_t>(bytes);
+
+		// The first two significant digits select one of 90 buckets within its power of ten.
+		int exponent = DecimalExponent(bytes);
+
+		return 100 + static_cast<std::size_t>(exponent - 2) * 90 + static_cast<std::size_t>(bytes / BUCKET_POWERS_OF_TEN[exponent - 1] - 10);
+
+	}
+	BYTESIZE_INLINE std::uint64_t ByteSizeHistogram::BucketLowerBound(std::size_t index, BytePrefix prefix) {
+
+		if (prefix == BytePrefix::Binary) {
+
+			if (index < 32)
+				return index;
+
+			return (32 + (index - 32) % 32) << ((index - 32) / 32);
+
+		}
+
+		if (index < 100)
+			return index;
+
+		return (10 + (index - 100) % 90) * BUCKET_POWERS_OF_TEN[(index - 100) / 90 + 1];
+
+	}
+	BYTESIZE_INLINE std::uint64_t ByteSizeHistogram::BucketUpperBound(std::size_t index, BytePrefix prefix) {
+
+		if (index + 1 >= BucketCount(prefix))
+			return UINT64_MAX;
+
+		return BucketLowerBound(index + 1, prefix) - 1;
+
+	}
+
+	BYTESIZE_INLINE ByteSize ByteSizeHistogram::FromBytes(std::uint64_t bytes) const {
+
+		return ByteSize(bytes, _prefix);
+
+	}
+
+}
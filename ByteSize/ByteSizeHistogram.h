@@ -0,0 +1,82 @@
+#pragma once
+#include "ByteSize.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hvn3 {
+
+	// A histogram of sizes with log-linear buckets, in the style of HDR histograms, taking a fixed amount of memory.
+	// With a binary prefix, each power of two is split into 32 buckets (at most about 3% wide). With a decimal prefix, each power of ten is split
+	// into 90 buckets by its first two significant digits. Either way every unit (1 KiB, 1 MiB, ... or 1 kB, 1 MB, ...) starts a bucket, and
+	// sizes under 32 or 100 bytes are counted exactly.
+	// Recording is not synchronized: give each thread its own histogram and Merge them when reporting.
+	class ByteSizeHistogram {
+
+	public:
+		static constexpr BytePrefix DEFAULT_PREFIX = ByteSize::DEFAULT_PREFIX;
+
+		explicit ByteSizeHistogram(BytePrefix prefix = DEFAULT_PREFIX);
+
+		BytePrefix Prefix() const;
+
+		// Counts a size, rounded down to a whole number of bytes. Negative sizes are counted as zero.
+		void Record(const ByteSize& size);
+		void Record(const ByteSize& size, std::uint64_t count);
+		// Adds the counts of another histogram with the same prefix.
+		void Merge(const ByteSizeHistogram& other);
+		void Reset();
+
+		std::uint64_t Count() const;
+		ByteSize Sum() const;
+		ByteSize Mean() const;
+		ByteSize Min() const;
+		ByteSize Max() const;
+
+		// Returns the size below which the given percentage (0 to 100) of recorded sizes fall, to within the width of a bucket.
+		ByteSize Percentile(double percentile) const;
+		// Same as Percentile, but takes a fraction from 0 to 1.
+		ByteSize Quantile(double quantile) const;
+
+		// Returns a summary such as "count 1000, p50 1.50 KiB, p99 12.00 MiB, p99.9 15.75 MiB, max 16.00 MiB".
+		std::string ToString(unsigned int precision = 2) const;
+
+		// Returns the number of recorded sizes in the bucket with the given index.
+		std::uint64_t CountInBucket(std::size_t index) const;
+
+		static constexpr std::size_t BucketCount(BytePrefix prefix);
+		// Returns the index of the bucket holding the given number of bytes.
+		static std::size_t BucketIndex(std::uint64_t bytes, BytePrefix prefix);
+		// Returns the smallest and largest number of bytes counted by a bucket.
+		static std::uint64_t BucketLowerBound(std::size_t index, BytePrefix prefix);
+		static std::uint64_t BucketUpperBound(std::size_t index, BytePrefix prefix);
+
+	private:
+		// 32 exact buckets, then 32 for each power of two from 2^5 to 2^63.
+		static constexpr std::size_t BINARY_BUCKET_COUNT = 32 + 59 * 32;
+		// 100 exact buckets, then 90 for each power of ten from 10^2 to 10^18, and 9 more for 10^19 up to the largest 64-bit count.
+		static constexpr std::size_t DECIMAL_BUCKET_COUNT = 100 + 17 * 90 + 9;
+
+		ByteSize FromBytes(std::uint64_t bytes) const;
+
+		BytePrefix _prefix;
+		std::uint64_t _count;
+		BitCount _sum_bits;
+		std::uint64_t _min;
+		std::uint64_t _max;
+		std::array<std::uint64_t, (BINARY_BUCKET_COUNT > DECIMAL_BUCKET_COUNT ? BINARY_BUCKET_COUNT : DECIMAL_BUCKET_COUNT)> _buckets;
+
+	};
+
+	constexpr std::size_t ByteSizeHistogram::BucketCount(BytePrefix prefix) {
+
+		return prefix == BytePrefix::Binary ? BINARY_BUCKET_COUNT : DECIMAL_BUCKET_COUNT;
+
+	}
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "ByteSizeHistogram.cc"
+#endif
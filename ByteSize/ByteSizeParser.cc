@@ -0,0 +1,106 @@
+#include "ByteSizeParser.h"
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace hvn3 {
+	namespace internal {
+
+		// Returns the field at the given column of [first, last) without surrounding whitespace or quotes, or an empty view if the line has
+		// too few fields.
+		static std::string_view FindField(const char* first, const char* last, const ParseManyOptions& options) {
+
+			for (std::size_t column = 0; column < options.column; ++column) {
+
+				const char* delimiter = static_cast<const char*>(std::memchr(first, options.delimiter, static_cast<std::size_t>(last - first)));
+
+				if (delimiter == nullptr)
+					return std::string_view();
+
+				first = delimiter + 1;
+
+			}
+
+			const char* delimiter = static_cast<const char*>(std::memchr(first, options.delimiter, static_cast<std::size_t>(last - first)));
+
+			if (delimiter != nullptr)
+				last = delimiter;
+
+			while (first != last && IsSpace(*first))
+				++first;
+			while (first != last && IsSpace(last[-1]))
+				--last;
+
+			if (last - first >= 2 && *first == '"' && last[-1] == '"') {
+
+				++first;
+				--last;
+
+			}
+
+			return std::string_view(first, static_cast<std::size_t>(last - first));
+
+		}
+
+		BYTESIZE_INLINE ParseError FromChars(const char* first, const char* last, double& value) {
+
+			std::from_chars_result result = std::from_chars(first, last, value);
+
+			if (result.ec == std::errc::result_out_of_range)
+				return ParseError::NumberOutOfRange;
+			if (result.ec != std::errc() || result.ptr != last)
+				return ParseError::InvalidNumber;
+
+			return ParseError::None;
+
+		}
+
+	}
+
+	BYTESIZE_INLINE ParseManyResult ParseSizes(std::string_view buffer, double defaultUnitBytes, const ParseManyOptions& options, BitCount* counts, std::size_t countsSize, std::size_t* invalidRows, std::size_t invalidRowsSize) {
+
+		const char* first = buffer.data();
+		const char* last = first + buffer.size();
+		const char* line = first;
+		ParseManyResult result = { 0, 0, 0 };
+
+		while (line != last && result.rows < countsSize) {
+
+			const char* line_last = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(last - line)));
+
+			if (line_last == nullptr) {
+
+				if (!options.final)
+					break;
+
+				line_last = last;
+
+			}
+
+			std::string_view field = internal::FindField(line, line_last, options);
+			ParsedSize size{};
+
+			if (!field.empty() && ParseSize(field, defaultUnitBytes, size))
+				counts[result.rows] = size.exact ? size.bits : BytesToBits(size.bytes);
+			else {
+
+				if (result.invalidRows == invalidRowsSize)
+					break;
+
+				counts[result.rows] = 0;
+				invalidRows[result.invalidRows++] = result.rows;
+
+			}
+
+			++result.rows;
+			line = line_last == last ? last : line_last + 1;
+
+		}
+
+		result.position = static_cast<std::size_t>(line - first);
+
+		return result;
+
+	}
+
+}
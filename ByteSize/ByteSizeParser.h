@@ -0,0 +1,483 @@
+#pragma once
+#include "ByteSizeCommon.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace hvn3 {
+
+	enum class ParseError {
+		None,
+		// The input did not start with a number.
+		InvalidNumber,
+		// The number was too large to be represented.
+		NumberOutOfRange,
+		// The unit following the number was not recognized.
+		InvalidSuffix,
+		// Unexpected characters followed the unit.
+		TrailingCharacters
+	};
+
+	struct ParseResult {
+		ParseError error;
+		// Offset of the character at which parsing failed, or the length of the input on success.
+		std::size_t position;
+
+		constexpr explicit operator bool() const {
+			return error == ParseError::None;
+		}
+	};
+
+	struct ParsedSize {
+		double bytes;
+		// The size as an exact bit count, if exact is true: when the number is a whole number without an exponent, and the unit is a whole
+		// number of bits. Otherwise only bytes is set, and may have been rounded.
+		BitCount bits;
+		bool exact;
+		BytePrefix prefix;
+		ByteUnit unit;
+	};
+
+	struct ParseManyOptions {
+		// Zero-based index of the field holding the size on each line.
+		std::size_t column = 0;
+		// Character separating fields within a line, e.g. '\t' for du output or ',' for CSV files.
+		char delimiter = '\t';
+		// True if the buffer ends the input. Otherwise a last line without a newline is left for the next call, so input can be parsed in
+		// blocks as it is read.
+		bool final = true;
+	};
+
+	struct ParseManyResult {
+		// Number of lines read, including invalid ones.
+		std::size_t rows;
+		// Number of row indices written to the invalid rows array.
+		std::size_t invalidRows;
+		// Offset of the first line that was not read. Parsing stops early if either output array fills up.
+		std::size_t position;
+	};
+
+	namespace internal {
+
+		// Spelled-out magnitudes, indexed by magnitude and then by BytePrefix.
+		inline constexpr std::string_view MAGNITUDE_NAMES[][2] = {
+			{ "", "" },
+			{ "kilo", "kibi" },
+			{ "mega", "mebi" },
+			{ "giga", "gibi" },
+			{ "tera", "tebi" },
+			{ "peta", "pebi" },
+			{ "exa", "exbi" },
+			{ "zetta", "zebi" },
+			{ "yotta", "yobi" }
+		};
+
+		// Powers of ten that are exactly representable as doubles.
+		inline constexpr double EXACT_POWERS_OF_TEN[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		// Converts [first, last) with std::from_chars. Used at runtime for numbers that ParseNumber cannot convert exactly.
+		ParseError FromChars(const char* first, const char* last, double& value);
+
+		constexpr bool IsSpace(char c) {
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+		constexpr bool IsDigit(char c) {
+			return c >= '0' && c <= '9';
+		}
+		constexpr bool IsAlpha(char c) {
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+		}
+		constexpr char ToLower(char c) {
+			return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+		constexpr bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+
+			if (lhs.size() != rhs.size())
+				return false;
+
+			for (std::size_t i = 0; i < lhs.size(); ++i)
+				if (ToLower(lhs[i]) != rhs[i])
+					return false;
+
+			return true;
+
+		}
+		constexpr bool IsBitName(std::string_view name) {
+			return EqualsIgnoreCase(name, "bit") || EqualsIgnoreCase(name, "bits");
+		}
+		constexpr bool IsByteName(std::string_view name) {
+			return EqualsIgnoreCase(name, "byte") || EqualsIgnoreCase(name, "bytes");
+		}
+		constexpr int MagnitudeOf(char symbol) {
+
+			switch (symbol) {
+			case 'k':
+			case 'K':
+				return 1;
+			case 'M':
+				return 2;
+			case 'G':
+				return 3;
+			case 'T':
+				return 4;
+			case 'P':
+				return 5;
+			case 'E':
+				return 6;
+			case 'Z':
+				return 7;
+			case 'Y':
+				return 8;
+			}
+
+			return 0;
+
+		}
+		constexpr int MagnitudeOfName(char c) {
+
+			switch (ToLower(c)) {
+			case 'k':
+				return 1;
+			case 'm':
+				return 2;
+			case 'g':
+				return 3;
+			case 't':
+				return 4;
+			case 'p':
+				return 5;
+			case 'e':
+				return 6;
+			case 'z':
+				return 7;
+			case 'y':
+				return 8;
+			}
+
+			return 0;
+
+		}
+		// Returns the number of bits in the unit, or zero if it is too large for a BitCount.
+		constexpr BitCount UnitBits(int magnitude, BytePrefix prefix, bool bits) {
+
+			UnsignedBitCount bits_in_unit = bits ? 1 : 8;
+
+			if (prefix == BytePrefix::Binary)
+				return 10 * magnitude + (bits ? 0 : 3) < static_cast<int>(sizeof(BitCount) * 8) - 1 ? static_cast<BitCount>(bits_in_unit << (10 * magnitude)) : 0;
+
+			return DECIMAL_UNIT_COUNTS[magnitude] <= static_cast<UnsignedBitCount>(MaxBitCount()) / bits_in_unit ? static_cast<BitCount>(DECIMAL_UNIT_COUNTS[magnitude] * bits_in_unit) : 0;
+
+		}
+		// Returns the number of bits in a unit of the given number of bytes, or zero if it is not a whole number of bits that fits in a
+		// BitCount.
+		constexpr BitCount UnitBits(double unitBytes) {
+
+			double bits = unitBytes * 8.0;
+
+			if (!(bits >= 1.0 && bits < static_cast<double>(MaxBitCount())))
+				return 0;
+
+			return static_cast<double>(static_cast<BitCount>(bits)) == bits ? static_cast<BitCount>(bits) : 0;
+
+		}
+		// Reads [first, last) as a whole number ("-12"), saturating if it is too large. Returns false if it has a fraction or an exponent.
+		constexpr bool ParseInteger(const char* first, const char* last, BitCount& value) {
+
+			bool negative = first != last && *first == '-';
+
+			if (negative)
+				++first;
+
+			value = 0;
+
+			for (; first != last; ++first) {
+
+				if (!IsDigit(*first))
+					return false;
+
+				value = SaturatingAdd(SaturatingMultiply(value, 10), negative ? -(*first - '0') : *first - '0');
+
+			}
+
+			return true;
+
+		}
+		constexpr void SetUnit(ParsedSize& result, int magnitude, BytePrefix prefix, ByteUnit unit, bool bits) {
+
+			// The bit count holds the size of the unit until the number is multiplied in.
+			result.bytes = UNIT_MULTIPLIERS[static_cast<int>(prefix)][magnitude] / (bits ? 8. : 1.);
+			result.bits = UnitBits(magnitude, prefix, bits);
+			result.prefix = prefix;
+			result.unit = unit;
+
+		}
+		constexpr bool MatchLongSuffix(std::string_view suffix, ParsedSize& result) {
+
+			if (IsBitName(suffix) || IsByteName(suffix)) {
+
+				SetUnit(result, 0, BytePrefix::Binary, ByteUnit::IEC, IsBitName(suffix));
+
+				return true;
+
+			}
+
+			int magnitude = MagnitudeOfName(suffix[0]);
+
+			if (magnitude == 0)
+				return false;
+
+			for (BytePrefix prefix : { BytePrefix::Decimal, BytePrefix::Binary }) {
+
+				std::string_view magnitude_name = MAGNITUDE_NAMES[magnitude][static_cast<int>(prefix)];
+				std::string_view name = suffix.substr((std::min)(magnitude_name.size(), suffix.size()));
+
+				if ((IsBitName(name) || IsByteName(name)) && EqualsIgnoreCase(suffix.substr(0, magnitude_name.size()), magnitude_name)) {
+
+					SetUnit(result, magnitude, prefix, prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric, IsBitName(name));
+
+					return true;
+
+				}
+
+			}
+
+			return false;
+
+		}
+		constexpr bool MatchSuffix(std::string_view suffix, ParsedSize& result) {
+
+			if (suffix == "b" || suffix == "B") {
+
+				SetUnit(result, 0, BytePrefix::Binary, ByteUnit::IEC, suffix == "b");
+
+				return true;
+
+			}
+
+			int magnitude = MagnitudeOf(suffix[0]);
+
+			if (magnitude == 0)
+				return MatchLongSuffix(suffix, result);
+
+			std::string_view rest = suffix.substr(1);
+
+			// Only "K" distinguishes JEDEC (KB) from metric (kB); the larger magnitudes share their symbols and have always been read as metric.
+			BytePrefix prefix = suffix[0] == 'K' ? BytePrefix::Binary : BytePrefix::Decimal;
+			ByteUnit unit = suffix[0] == 'K' ? ByteUnit::JEDEC : ByteUnit::Metric;
+
+			if (rest.empty())
+				SetUnit(result, magnitude, BytePrefix::Binary, ByteUnit::JEDEC, false);
+			else if (rest == "iB")
+				SetUnit(result, magnitude, BytePrefix::Binary, ByteUnit::IEC, false);
+			else if (rest == "ib" || rest == "ibit")
+				SetUnit(result, magnitude, BytePrefix::Binary, ByteUnit::IEC, true);
+			else if (rest == "B")
+				SetUnit(result, magnitude, prefix, unit, false);
+			else if (rest == "b" || rest == "bit")
+				SetUnit(result, magnitude, prefix, unit, true);
+			else
+				return MatchLongSuffix(suffix, result);
+
+			return true;
+
+		}
+		constexpr void AccumulateDigit(char c, bool fraction, std::uint64_t& mantissa, int& digits, int& exponent, bool& truncated) {
+
+			// Keep the first 19 significant digits, which always fit in 64 bits, and track the scale of the rest.
+			if (digits < 19) {
+
+				mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+
+				if (mantissa != 0)
+					++digits;
+				if (fraction)
+					--exponent;
+
+			}
+			else {
+
+				truncated = truncated || c != '0';
+
+				if (!fraction)
+					++exponent;
+
+			}
+
+		}
+
+		// Reads a decimal number ("-12", "1.5", ".5", "2e3") starting at it, accepting the same syntax as std::from_chars.
+		// Numbers whose digits fit in a double's 53-bit mantissa and have a small exponent are converted exactly with a single multiplication or
+		// division (Clinger's fast path). Other numbers are converted with std::from_chars at runtime, or approximated during constant
+		// evaluation.
+		constexpr ParseError ParseNumber(const char*& it, const char* last, double& value) {
+
+			const char* first = it;
+			bool negative = it != last && *it == '-';
+
+			if (negative)
+				++it;
+
+			std::uint64_t mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool truncated = false;
+			bool any_digits = false;
+
+			for (; it != last && IsDigit(*it); ++it, any_digits = true)
+				AccumulateDigit(*it, false, mantissa, digits, exponent, truncated);
+
+			if (it != last && *it == '.')
+				for (++it; it != last && IsDigit(*it); ++it, any_digits = true)
+					AccumulateDigit(*it, true, mantissa, digits, exponent, truncated);
+
+			if (!any_digits)
+				return ParseError::InvalidNumber;
+
+			// The exponent is only consumed if it contains at least one digit, so "1E" leaves the "E" for the suffix.
+			if (it != last && (*it == 'e' || *it == 'E')) {
+
+				const char* exponent_it = it + 1;
+				bool negative_exponent = exponent_it != last && *exponent_it == '-';
+
+				if (exponent_it != last && (*exponent_it == '-' || *exponent_it == '+'))
+					++exponent_it;
+
+				if (exponent_it != last && IsDigit(*exponent_it)) {
+
+					int exponent_value = 0;
+
+					for (it = exponent_it; it != last && IsDigit(*it); ++it)
+						if (exponent_value < 100000)
+							exponent_value = exponent_value * 10 + (*it - '0');
+
+					exponent += negative_exponent ? -exponent_value : exponent_value;
+
+				}
+
+			}
+
+			if (mantissa == 0)
+				value = 0.0;
+			else if (!truncated && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+				value = exponent < 0 ? static_cast<double>(mantissa) / EXACT_POWERS_OF_TEN[-exponent] : static_cast<double>(mantissa) * EXACT_POWERS_OF_TEN[exponent];
+			else if (!IsConstantEvaluated())
+				return FromChars(first, it, value);
+			else {
+
+				value = static_cast<double>(mantissa);
+
+				for (int step = 0; exponent > 0; exponent -= step) {
+
+					step = exponent < 22 ? exponent : 22;
+
+					if (value > DBL_MAX / EXACT_POWERS_OF_TEN[step])
+						return ParseError::NumberOutOfRange;
+
+					value *= EXACT_POWERS_OF_TEN[step];
+
+				}
+				for (int step = 0; exponent < 0 && value != 0.0; exponent += step) {
+
+					step = -exponent < 22 ? -exponent : 22;
+					value /= EXACT_POWERS_OF_TEN[step];
+
+				}
+
+			}
+
+			if (negative)
+				value = -value;
+
+			return ParseError::None;
+
+		}
+
+	}
+
+	// Parses a quantity such as "1.5 KiB", "10Gbit", "4.0K" or "3 megabytes" without allocating.
+	// Symbols are case-sensitive ("b" is a bit, "B" is a byte), while spelled-out units are not. Single-letter units ("K", "M", ...) are
+	// read as binary bytes, as printed by tools like du. A number without a unit is multiplied by defaultUnitBytes.
+	// Parsing is constexpr, so sizes can be parsed at compile time.
+	constexpr ParseResult ParseSize(std::string_view string, double defaultUnitBytes, ParsedSize& result) {
+
+		const char* first = string.data();
+		const char* last = first + string.size();
+		const char* it = first;
+
+		while (it != last && internal::IsSpace(*it))
+			++it;
+
+		// Like std::from_chars, ParseNumber accepts neither a leading '+' nor "inf"/"nan", so only let through what looks like a number.
+		const char* number = it;
+
+		if (number != last && *number == '+')
+			++number;
+
+		const char* digits = (number == it && number != last && *number == '-') ? number + 1 : number;
+
+		if (digits == last || !(internal::IsDigit(*digits) || *digits == '.'))
+			return { ParseError::InvalidNumber, static_cast<std::size_t>(it - first) };
+
+		const char* number_first = number;
+		double value = 0.0;
+		ParseError number_error = internal::ParseNumber(number, last, value);
+
+		if (number_error != ParseError::None)
+			return { number_error, static_cast<std::size_t>(it - first) };
+
+		it = number;
+
+		while (it != last && internal::IsSpace(*it))
+			++it;
+
+		const char* suffix_first = it;
+
+		while (it != last && internal::IsAlpha(*it))
+			++it;
+
+		std::string_view suffix(suffix_first, static_cast<std::size_t>(it - suffix_first));
+
+		if (suffix.empty()) {
+
+			result.bytes = defaultUnitBytes;
+			result.bits = internal::UnitBits(defaultUnitBytes);
+			result.prefix = BytePrefix::Binary;
+			result.unit = ByteUnit::IEC;
+
+		}
+		else if (!internal::MatchSuffix(suffix, result))
+			return { ParseError::InvalidSuffix, static_cast<std::size_t>(suffix_first - first) };
+
+		while (it != last && internal::IsSpace(*it))
+			++it;
+
+		if (it != last)
+			return { ParseError::TrailingCharacters, static_cast<std::size_t>(it - first) };
+
+		// Whole numbers are multiplied exactly, so sizes past 2^53 bytes aren't rounded to a double.
+		BitCount integer = 0;
+
+		result.bytes *= value;
+		result.exact = result.bits != 0 && internal::ParseInteger(number_first, number, integer);
+		result.bits = result.exact ? SaturatingMultiply(integer, result.bits) : 0;
+
+		return { ParseError::None, string.size() };
+
+	}
+
+	// Parses one size per line from a column of delimited text, such as du output or a CSV export, writing the exact bit count of each row
+	// to counts. Rows whose field is missing or malformed are counted as zero and their indices (relative to the start of buffer) are
+	// written to invalidRows. Delimiters are found with memchr and nothing is allocated. A field may be surrounded by double quotes, but
+	// quoted fields cannot contain the delimiter.
+	ParseManyResult ParseSizes(std::string_view buffer, double defaultUnitBytes, const ParseManyOptions& options, BitCount* counts, std::size_t countsSize, std::size_t* invalidRows, std::size_t invalidRowsSize);
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "ByteSizeParser.cc"
+#endif
@@ -0,0 +1,294 @@
+#include "MemoryAccount.h"
+#include <algorithm>
+#include <utility>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE MemoryAccount::MemoryAccount(std::string name, std::size_t foldThreshold) :
+		_name(std::move(name)),
+		_fold_threshold(foldThreshold),
+		_counters(std::make_shared<Counters>()) {
+
+		Slots& slots = AccountSlots();
+		std::size_t slot_count;
+
+		{
+			std::lock_guard<std::mutex> lock(slots.mutex);
+
+			if (slots.free_indices.empty()) {
+
+				_index = slots.generations.size();
+
+				slots.generations.push_back(0);
+
+			}
+			else {
+
+				_index = slots.free_indices.back();
+
+				slots.free_indices.pop_back();
+
+			}
+
+			// Generations start at one, so that a slot that has never been used (generation zero) belongs to no account.
+			_generation = ++slots.generations[_index];
+			slot_count = slots.generations.size();
+
+			slots.count.store(slot_count, std::memory_order_relaxed);
+
+		}
+
+		// Make room in the constructing thread, which is likely to use the account, so that its first allocation doesn't have to.
+		if (LocalAccounts* thread_accounts = ThreadAccounts())
+			Reserve(*thread_accounts, slot_count);
+
+	}
+	BYTESIZE_INLINE MemoryAccount::~MemoryAccount() {
+
+		_counters->destroyed.store(true, std::memory_order_relaxed);
+
+		Slots& slots = AccountSlots();
+		std::lock_guard<std::mutex> lock(slots.mutex);
+
+		slots.free_indices.push_back(_index);
+
+	}
+
+	BYTESIZE_INLINE const std::string& MemoryAccount::Name() const {
+
+		return _name;
+
+	}
+
+	BYTESIZE_INLINE void MemoryAccount::Allocate(std::size_t bytes) {
+
+		LocalCounters* local = Local();
+
+		if (local == nullptr) {
+
+			Add(static_cast<std::int64_t>(bytes), bytes, 1, bytes);
+
+			return;
+
+		}
+
+		local->live += static_cast<std::int64_t>(bytes);
+		local->total += bytes;
+		local->allocations += 1;
+		local->activity += bytes;
+
+		if (local->activity >= _fold_threshold)
+			Fold(*local);
+
+	}
+	BYTESIZE_INLINE void MemoryAccount::Deallocate(std::size_t bytes) {
+
+		LocalCounters* local = Local();
+
+		if (local == nullptr) {
+
+			Add(-static_cast<std::int64_t>(bytes), 0, 0, bytes);
+
+			return;
+
+		}
+
+		local->live -= static_cast<std::int64_t>(bytes);
+		local->activity += bytes;
+
+		if (local->activity >= _fold_threshold)
+			Fold(*local);
+
+	}
+	BYTESIZE_INLINE void MemoryAccount::Flush() {
+
+		if (LocalCounters* local = Local())
+			Fold(*local);
+
+	}
+
+	BYTESIZE_INLINE ByteSize MemoryAccount::Live() const {
+
+		return ByteSize(_counters->live.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE ByteSize MemoryAccount::Peak() const {
+
+		return ByteSize(_counters->peak.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE ByteSize MemoryAccount::Total() const {
+
+		return ByteSize(_counters->total.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE std::uint64_t MemoryAccount::Allocations() const {
+
+		return _counters->allocations.load(std::memory_order_relaxed);
+
+	}
+
+	BYTESIZE_INLINE std::string MemoryAccount::ToString(unsigned int precision) const {
+
+		return _name + ": live " + Live().ToString(precision) + ", peak " + Peak().ToString(precision) + ", total " + Total().ToString(precision) +
+			" in " + std::to_string(Allocations()) + " allocations";
+
+	}
+
+	BYTESIZE_INLINE MemoryAccount::LocalAccounts::~LocalAccounts() {
+
+		// From here on, the thread's allocations are counted directly in the shared counters, including those made while folding.
+		destroyed = true;
+
+		for (LocalCounters& local : accounts)
+			Fold(local);
+
+	}
+
+	BYTESIZE_INLINE MemoryAccount::LocalCounters* MemoryAccount::Local() {
+
+		LocalAccounts* thread_accounts = ThreadAccounts();
+
+		// The slots may have been destroyed, or be in the middle of being moved to new storage.
+		if (thread_accounts == nullptr || thread_accounts->growing)
+			return nullptr;
+
+		if (_index >= thread_accounts->accounts.size()) {
+
+			// Room is made for every index handed out so far, so that the thread grows again only when more accounts are alive at once.
+			Reserve(*thread_accounts, (std::max)(_index + 1, AccountSlots().count.load(std::memory_order_relaxed)));
+
+		}
+
+		LocalCounters& local = thread_accounts->accounts[_index];
+
+		// A slot left by a destroyed account that used the same index. Its pending counts can no longer be read by anyone, so they are
+		// dropped along with its counters.
+		if (local.generation != _generation)
+			local = LocalCounters{ _counters, 0, 0, 0, 0, _generation };
+
+		return &local;
+
+	}
+	BYTESIZE_INLINE void MemoryAccount::Add(std::int64_t live, std::uint64_t total, std::uint64_t allocations, std::size_t activity) {
+
+		LocalCounters direct{ _counters, live, total, allocations, activity, _generation };
+
+		Fold(direct);
+
+	}
+
+	BYTESIZE_INLINE MemoryAccount::Slots& MemoryAccount::AccountSlots() {
+
+		static Slots slots;
+
+		return slots;
+
+	}
+	BYTESIZE_INLINE MemoryAccount::LocalAccounts* MemoryAccount::ThreadAccounts() {
+
+		// The flag is trivially destructible, so unlike the accounts, it can still be read after the thread's destructors have run.
+		thread_local bool destroyed = false;
+
+		if (destroyed)
+			return nullptr;
+
+		thread_local LocalAccounts accounts(destroyed);
+
+		return &accounts;
+
+	}
+	BYTESIZE_INLINE void MemoryAccount::Reserve(LocalAccounts& local, std::size_t size) {
+
+		if (size <= local.accounts.size() || local.growing)
+			return;
+
+		// Allocations made while growing are counted directly in the shared counters (see Local).
+		local.growing = true;
+
+		try {
+
+			local.accounts.resize(size, LocalCounters{ nullptr, 0, 0, 0, 0, 0 });
+
+		}
+		catch (...) {
+
+			local.growing = false;
+
+			throw;
+
+		}
+
+		local.growing = false;
+
+	}
+	BYTESIZE_INLINE void MemoryAccount::Fold(LocalCounters& local) {
+
+		if (!local.counters || local.activity == 0)
+			return;
+
+		Counters& counters = *local.counters;
+
+		std::int64_t live = counters.live.fetch_add(local.live, std::memory_order_relaxed) + local.live;
+		std::int64_t peak = counters.peak.load(std::memory_order_relaxed);
+
+		while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+		}
+
+		counters.total.fetch_add(local.total, std::memory_order_relaxed);
+		counters.allocations.fetch_add(local.allocations, std::memory_order_relaxed);
+
+		local.live = 0;
+		local.total = 0;
+		local.allocations = 0;
+		local.activity = 0;
+
+		// Nothing can read the counters of a destroyed account, so there is no reason to keep them alive for later folds.
+		if (counters.destroyed.load(std::memory_order_relaxed))
+			local.counters.reset();
+
+	}
+
+#if __has_include(<memory_resource>)
+
+	BYTESIZE_INLINE AccountingMemoryResource::AccountingMemoryResource(MemoryAccount& account, std::pmr::memory_resource* upstream) noexcept :
+		_account(&account),
+		_upstream(upstream) {
+	}
+
+	BYTESIZE_INLINE MemoryAccount& AccountingMemoryResource::Account() const noexcept {
+
+		return *_account;
+
+	}
+	BYTESIZE_INLINE std::pmr::memory_resource* AccountingMemoryResource::Upstream() const noexcept {
+
+		return _upstream;
+
+	}
+
+	BYTESIZE_INLINE void* AccountingMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+
+		void* pointer = _upstream->allocate(bytes, alignment);
+
+		_account->Allocate(bytes);
+
+		return pointer;
+
+	}
+	BYTESIZE_INLINE void AccountingMemoryResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+
+		_upstream->deallocate(pointer, bytes, alignment);
+
+		_account->Deallocate(bytes);
+
+	}
+	BYTESIZE_INLINE bool AccountingMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+
+		return this == &other;
+
+	}
+
+#endif
+
+}
@@ -0,0 +1,211 @@
+#pragma once
+#include "ByteSize.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace hvn3 {
+
+	// Counts the memory held by one subsystem: the bytes currently allocated (live), the most ever allocated at once (peak), and the bytes
+	// and number of allocations made in total.
+	// Allocations and deallocations only update counters local to the calling thread, which are folded into the shared counters once
+	// foldThreshold bytes have passed through them, and when the thread exits. The shared counters therefore trail each thread by less than
+	// foldThreshold, and the peak is measured at fold time. Call Flush to fold the calling thread's counters immediately.
+	// Each thread keeps one slot per account that is alive at the same time, so creating and destroying accounts doesn't grow it. A thread's
+	// slots are allocated the first time it uses an account beyond those it has room for; the constructing thread has room made ahead of time.
+	class MemoryAccount {
+
+	public:
+		static constexpr std::size_t DEFAULT_FOLD_THRESHOLD = 64 * 1024;
+
+		explicit MemoryAccount(std::string name, std::size_t foldThreshold = DEFAULT_FOLD_THRESHOLD);
+		MemoryAccount(const MemoryAccount&) = delete;
+		~MemoryAccount();
+
+		const std::string& Name() const;
+
+		void Allocate(std::size_t bytes);
+		void Deallocate(std::size_t bytes);
+		void Flush();
+
+		ByteSize Live() const;
+		ByteSize Peak() const;
+		ByteSize Total() const;
+		std::uint64_t Allocations() const;
+
+		// Returns a summary such as "parser: live 1.50 MiB, peak 4.00 MiB, total 96.00 MiB in 1200 allocations".
+		std::string ToString(unsigned int precision = 2) const;
+
+		MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+	private:
+		struct Counters {
+			std::atomic<std::int64_t> live{ 0 };
+			std::atomic<std::int64_t> peak{ 0 };
+			std::atomic<std::uint64_t> total{ 0 };
+			std::atomic<std::uint64_t> allocations{ 0 };
+			// Set when the account is destroyed, so that threads can release the counters once they have folded them.
+			std::atomic<bool> destroyed{ false };
+		};
+
+		struct LocalCounters {
+			std::shared_ptr<Counters> counters;
+			std::int64_t live;
+			std::uint64_t total;
+			std::uint64_t allocations;
+			std::size_t activity;
+			// The generation of the account the slot belongs to. Slots are reused by later accounts, which have a new generation.
+			std::uint64_t generation;
+		};
+
+		// Holds the calling thread's counters for every account it has used, indexed by account, and folds them when the thread exits.
+		class LocalAccounts {
+
+		public:
+			explicit LocalAccounts(bool& destroyed) :
+				destroyed(destroyed) {
+			}
+			~LocalAccounts();
+
+			std::vector<LocalCounters> accounts;
+			// Set while accounts is being grown, since that allocates, and the allocation may be counted by an account itself.
+			bool growing = false;
+			// Set by the destructor, and outlives it.
+			bool& destroyed;
+
+		};
+
+		// Hands out slot indices, reusing those of destroyed accounts.
+		struct Slots {
+			std::mutex mutex;
+			std::vector<std::size_t> free_indices;
+			// The generation of the account currently using each index.
+			std::vector<std::uint64_t> generations;
+			// generations.size(), which threads read without taking the lock.
+			std::atomic<std::size_t> count{ 0 };
+		};
+
+		// Returns the calling thread's slot for the account, or nullptr if the thread's slots are being grown or have been destroyed.
+		LocalCounters* Local();
+		void Add(std::int64_t live, std::uint64_t total, std::uint64_t allocations, std::size_t activity);
+
+		static Slots& AccountSlots();
+		// Returns nullptr once the calling thread's accounts have been destroyed at thread exit. Other thread_local objects destroyed after
+		// them (e.g. containers using an AccountingAllocator) may still allocate and deallocate.
+		static LocalAccounts* ThreadAccounts();
+		static void Reserve(LocalAccounts& local, std::size_t size);
+		static void Fold(LocalCounters& local);
+
+		std::string _name;
+		std::size_t _fold_threshold;
+		std::size_t _index;
+		std::uint64_t _generation;
+		// Shared with the threads that have pending counts, so they can still be folded after the account is destroyed.
+		std::shared_ptr<Counters> _counters;
+
+	};
+
+	// An allocator adaptor that counts the memory allocated through it in a MemoryAccount.
+	template <typename T, typename Allocator = std::allocator<T>>
+	class AccountingAllocator {
+
+		typedef std::allocator_traits<Allocator> traits;
+
+	public:
+		typedef T value_type;
+
+		template <typename U>
+		struct rebind {
+			typedef AccountingAllocator<U, typename traits::template rebind_alloc<U>> other;
+		};
+
+		explicit AccountingAllocator(MemoryAccount& account, const Allocator& allocator = Allocator()) noexcept :
+			_account(&account),
+			_allocator(allocator) {
+		}
+		template <typename U, typename OtherAllocator>
+		AccountingAllocator(const AccountingAllocator<U, OtherAllocator>& other) noexcept :
+			_account(&other.Account()),
+			_allocator(other.Inner()) {
+		}
+
+		MemoryAccount& Account() const noexcept {
+			return *_account;
+		}
+		const Allocator& Inner() const noexcept {
+			return _allocator;
+		}
+
+		T* allocate(std::size_t count) {
+
+			T* pointer = traits::allocate(_allocator, count);
+
+			_account->Allocate(count * sizeof(T));
+
+			return pointer;
+
+		}
+		void deallocate(T* pointer, std::size_t count) {
+
+			traits::deallocate(_allocator, pointer, count);
+
+			_account->Deallocate(count * sizeof(T));
+
+		}
+
+	private:
+		MemoryAccount* _account;
+		Allocator _allocator;
+
+	};
+
+	template <typename T, typename TAllocator, typename U, typename UAllocator>
+	bool operator==(const AccountingAllocator<T, TAllocator>& lhs, const AccountingAllocator<U, UAllocator>& rhs) {
+
+		return &lhs.Account() == &rhs.Account() && lhs.Inner() == rhs.Inner();
+
+	}
+	template <typename T, typename TAllocator, typename U, typename UAllocator>
+	bool operator!=(const AccountingAllocator<T, TAllocator>& lhs, const AccountingAllocator<U, UAllocator>& rhs) {
+
+		return !(lhs == rhs);
+
+	}
+
+#if __has_include(<memory_resource>)
+
+	// A memory resource that counts the memory allocated through it in a MemoryAccount, and gets the memory from an upstream resource.
+	class AccountingMemoryResource :
+		public std::pmr::memory_resource {
+
+	public:
+		explicit AccountingMemoryResource(MemoryAccount& account, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+
+		MemoryAccount& Account() const noexcept;
+		std::pmr::memory_resource* Upstream() const noexcept;
+
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	private:
+		MemoryAccount* _account;
+		std::pmr::memory_resource* _upstream;
+
+	};
+
+#endif
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "MemoryAccount.cc"
+#endif
@@ -0,0 +1,300 @@
+#include "MemorySampler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE MemorySampler::MemorySampler() :
+		_page_size(4096) {
+
+		std::fill(std::begin(_files), std::end(_files), -1);
+
+#if defined(__linux__)
+
+		long page_size = sysconf(_SC_PAGESIZE);
+
+		if (page_size > 0)
+			_page_size = static_cast<std::uint64_t>(page_size);
+
+		_files[static_cast<std::size_t>(Source::Statm)] = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+		_files[static_cast<std::size_t>(Source::Status)] = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+		_files[static_cast<std::size_t>(Source::MemInfo)] = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+
+		// With cgroup v2, /proc/self/cgroup has a single line of the form "0::/path/of/the/cgroup".
+		int cgroup = open("/proc/self/cgroup", O_RDONLY | O_CLOEXEC);
+
+		if (cgroup >= 0) {
+
+			ssize_t count = read(cgroup, _buffer, BUFFER_SIZE);
+
+			close(cgroup);
+
+			const char* first = _buffer;
+			const char* last = _buffer + (count > 0 ? count : 0);
+
+			for (const char* line = first; line < last; ) {
+
+				const char* end = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(last - line)));
+
+				if (end == nullptr)
+					end = last;
+
+				if (end - line >= 3 && std::strncmp(line, "0::", 3) == 0) {
+
+					std::string directory = "/sys/fs/cgroup" + std::string(line + 3, end);
+
+					if (directory.back() != '/')
+						directory += '/';
+
+					_files[static_cast<std::size_t>(Source::CgroupCurrent)] = open((directory + "memory.current").c_str(), O_RDONLY | O_CLOEXEC);
+					_files[static_cast<std::size_t>(Source::CgroupMax)] = open((directory + "memory.max").c_str(), O_RDONLY | O_CLOEXEC);
+
+					break;
+
+				}
+
+				line = end + 1;
+
+			}
+
+		}
+
+#endif
+
+	}
+	BYTESIZE_INLINE MemorySampler::~MemorySampler() {
+
+#if defined(__linux__)
+
+		for (int file : _files)
+			if (file >= 0)
+				close(file);
+
+#endif
+
+	}
+
+	BYTESIZE_INLINE bool MemorySampler::Sample(MemorySample& sample) {
+
+		sample = MemorySample();
+
+		bool sampled = false;
+		std::uint64_t value = 0;
+
+		if (std::size_t count = Read(Source::Statm)) {
+
+			const char* first = _buffer;
+			const char* last = _buffer + count;
+
+			// The fields are counted in pages: total program size, resident set size, and resident shared pages.
+			if (ReadNumber(first, last, value))
+				sample.virtual_size = ByteSize(value * _page_size);
+
+			if (ReadNumber(first, last, value))
+				sample.resident = ByteSize(value * _page_size);
+
+			if (ReadNumber(first, last, value))
+				sample.shared = ByteSize(value * _page_size);
+
+			sampled = true;
+
+		}
+
+		// Fields in /proc/self/status and /proc/meminfo are in kibibytes, though they are labelled "kB".
+		if (std::size_t count = Read(Source::Status)) {
+
+			if (ReadField(_buffer, _buffer + count, "VmHWM:", value))
+				sample.resident_peak = ByteSize(value * 1024);
+
+			sampled = true;
+
+		}
+
+		if (std::size_t count = Read(Source::MemInfo)) {
+
+			if (ReadField(_buffer, _buffer + count, "MemTotal:", value))
+				sample.system_total = ByteSize(value * 1024);
+
+			if (ReadField(_buffer, _buffer + count, "MemFree:", value))
+				sample.system_free = ByteSize(value * 1024);
+
+			if (ReadField(_buffer, _buffer + count, "MemAvailable:", value))
+				sample.system_available = ByteSize(value * 1024);
+
+			sampled = true;
+
+		}
+
+		if (std::size_t count = Read(Source::CgroupCurrent)) {
+
+			const char* first = _buffer;
+
+			if (ReadNumber(first, _buffer + count, value))
+				sample.cgroup_current = ByteSize(value);
+
+			sampled = true;
+
+		}
+
+		std::uint64_t limit = ReadLimit(Source::CgroupMax);
+
+		if (limit != UINT64_MAX)
+			sample.cgroup_limit = ByteSize(limit);
+
+		return sampled;
+
+	}
+	BYTESIZE_INLINE MemorySample MemorySampler::Sample() {
+
+		MemorySample sample;
+
+		Sample(sample);
+
+		return sample;
+
+	}
+
+	BYTESIZE_INLINE ByteSize MemorySampler::Resident() {
+
+		std::uint64_t pages = 0;
+
+		if (std::size_t count = Read(Source::Statm)) {
+
+			const char* first = _buffer;
+			const char* last = _buffer + count;
+
+			// Skip the total program size.
+			ReadNumber(first, last, pages);
+
+			if (!ReadNumber(first, last, pages))
+				pages = 0;
+
+		}
+
+		return ByteSize(pages * _page_size);
+
+	}
+	BYTESIZE_INLINE ByteSize MemorySampler::Available() {
+
+		std::uint64_t available = UINT64_MAX;
+		std::uint64_t value = 0;
+
+		if (std::size_t count = Read(Source::MemInfo))
+			if (ReadField(_buffer, _buffer + count, "MemAvailable:", value))
+				available = value * 1024;
+
+		std::uint64_t limit = ReadLimit(Source::CgroupMax);
+
+		if (limit != UINT64_MAX) {
+
+			std::uint64_t current = 0;
+
+			if (std::size_t count = Read(Source::CgroupCurrent)) {
+
+				const char* first = _buffer;
+
+				ReadNumber(first, _buffer + count, current);
+
+			}
+
+			available = std::min(available, limit > current ? limit - current : 0);
+
+		}
+
+		// Neither is known, e.g. on other platforms. Zero would tell the caller to shed load that there's no reason to.
+		if (available == UINT64_MAX)
+			return ByteSize::MaxValue();
+
+		return ByteSize(available);
+
+	}
+
+	BYTESIZE_INLINE std::size_t MemorySampler::Read(Source source) {
+
+#if defined(__linux__)
+
+		int file = _files[static_cast<std::size_t>(source)];
+
+		if (file < 0)
+			return 0;
+
+		ssize_t count = pread(file, _buffer, BUFFER_SIZE, 0);
+
+		return count > 0 ? static_cast<std::size_t>(count) : 0;
+
+#else
+
+		static_cast<void>(source);
+
+		return 0;
+
+#endif
+
+	}
+	BYTESIZE_INLINE std::uint64_t MemorySampler::ReadLimit(Source source) {
+
+		std::uint64_t limit = UINT64_MAX;
+
+		// The file holds either a number of bytes or "max".
+		if (std::size_t count = Read(source)) {
+
+			const char* first = _buffer;
+
+			if (!ReadNumber(first, _buffer + count, limit))
+				limit = UINT64_MAX;
+
+		}
+
+		return limit;
+
+	}
+
+	BYTESIZE_INLINE bool MemorySampler::ReadField(const char* first, const char* last, const char* key, std::uint64_t& value) {
+
+		std::size_t key_length = std::strlen(key);
+
+		for (const char* line = first; line < last; ) {
+
+			if (static_cast<std::size_t>(last - line) >= key_length && std::memcmp(line, key, key_length) == 0) {
+
+				line += key_length;
+
+				return ReadNumber(line, last, value);
+
+			}
+
+			const char* end = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(last - line)));
+
+			if (end == nullptr)
+				break;
+
+			line = end + 1;
+
+		}
+
+		return false;
+
+	}
+	BYTESIZE_INLINE bool MemorySampler::ReadNumber(const char*& first, const char* last, std::uint64_t& value) {
+
+		while (first < last && (*first == ' ' || *first == '\t'))
+			++first;
+
+		std::from_chars_result result = std::from_chars(first, last, value);
+
+		if (result.ec != std::errc())
+			return false;
+
+		first = result.ptr;
+
+		return true;
+
+	}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "ByteSize.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace hvn3 {
+
+	struct MemorySample {
+		// From /proc/self/statm.
+		ByteSize virtual_size{ 0 };
+		ByteSize resident{ 0 };
+		ByteSize shared{ 0 };
+		// VmHWM from /proc/self/status: the most the process has ever had resident.
+		ByteSize resident_peak{ 0 };
+		// MemTotal, MemFree and MemAvailable from /proc/meminfo.
+		ByteSize system_total{ 0 };
+		ByteSize system_free{ 0 };
+		ByteSize system_available{ 0 };
+		// memory.current and memory.max of the process's cgroup (v2). The limit is ByteSize::MaxValue() if there is none, or if the process
+		// is not in a cgroup with a memory controller.
+		ByteSize cgroup_current{ 0 };
+		ByteSize cgroup_limit = ByteSize::MaxValue();
+	};
+
+	// Samples the memory used by the process, the system and the process's cgroup on Linux, cheaply enough to be polled many times a second.
+	// The files are opened once, by the constructor, and each sample rereads them with pread into a fixed buffer and parses them without
+	// allocating. A sampler must not be used by more than one thread at a time.
+	// On other platforms, and for files that can't be read, values are zero (and the cgroup limit is ByteSize::MaxValue()).
+	class MemorySampler {
+
+	public:
+		MemorySampler();
+		MemorySampler(const MemorySampler&) = delete;
+		~MemorySampler();
+
+		// Reads every file. Returns false if none of them could be read.
+		bool Sample(MemorySample& sample);
+		MemorySample Sample();
+
+		// Returns the resident set size, reading only /proc/self/statm.
+		ByteSize Resident();
+		// Returns how much more memory can be used before the system or the cgroup runs out: the smaller of MemAvailable and the cgroup's
+		// limit less its usage. Useful for backing off under memory pressure. Returns ByteSize::MaxValue() if neither is known.
+		ByteSize Available();
+
+		MemorySampler& operator=(const MemorySampler&) = delete;
+
+	private:
+		enum class Source {
+			Statm,
+			Status,
+			MemInfo,
+			CgroupCurrent,
+			CgroupMax,
+			Count
+		};
+
+		static constexpr std::size_t BUFFER_SIZE = 4096;
+		static constexpr std::size_t SOURCE_COUNT = static_cast<std::size_t>(Source::Count);
+
+		// Reads the whole file (up to BUFFER_SIZE bytes) into the buffer, and returns the number of bytes read, or 0 if it can't be read.
+		std::size_t Read(Source source);
+		std::uint64_t ReadLimit(Source source);
+
+		// Finds the line starting with the key (e.g. "VmRSS:") and reads the number after it.
+		static bool ReadField(const char* first, const char* last, const char* key, std::uint64_t& value);
+		static bool ReadNumber(const char*& first, const char* last, std::uint64_t& value);
+
+		int _files[SOURCE_COUNT];
+		std::uint64_t _page_size;
+		char _buffer[BUFFER_SIZE];
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "MemorySampler.cc"
+#endif
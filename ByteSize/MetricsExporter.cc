@@ -0,0 +1,305 @@
+#include "MetricsExporter.h"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE MetricsExporter::MetricsExporter(bool annotateHelp) :
+		_annotate_help(annotateHelp) {
+	}
+
+	BYTESIZE_INLINE void MetricsExporter::AddCounter(std::string_view name, Source source, const MetricLabels& labels, std::string_view help) {
+
+		AddSeries(name, MetricType::Counter, std::move(source), labels, help);
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AddGauge(std::string_view name, Source source, const MetricLabels& labels, std::string_view help) {
+
+		AddSeries(name, MetricType::Gauge, std::move(source), labels, help);
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AddHistogram(std::string_view name, const ByteSizeHistogram& histogram, const std::vector<ByteSize>& boundaries, const MetricLabels& labels, std::string_view help) {
+
+		std::string label_string = FormatLabels(labels);
+		Family& family = GetFamily(name, MetricType::Histogram, help);
+		Series series;
+
+		series.histogram = &histogram;
+
+		std::vector<std::uint64_t> boundary_bytes;
+
+		for (const ByteSize& boundary : boundaries) {
+
+			if (boundary.ExactBits() < 8)
+				throw std::invalid_argument("Histogram boundaries must be at least one byte.");
+
+			BitCount bytes = boundary.ExactBits() / 8;
+
+			boundary_bytes.push_back(static_cast<UnsignedBitCount>(bytes) > UINT64_MAX ? UINT64_MAX : static_cast<std::uint64_t>(bytes));
+
+		}
+
+		std::sort(boundary_bytes.begin(), boundary_bytes.end());
+		boundary_bytes.erase(std::unique(boundary_bytes.begin(), boundary_bytes.end()), boundary_bytes.end());
+
+		std::string bucket_name = family.name + "_bucket{" + label_string + (label_string.empty() ? "" : ",") + "le=\"";
+
+		for (std::uint64_t bytes : boundary_bytes) {
+
+			series.bucket_prefixes.push_back(bucket_name + std::to_string(bytes) + "\"} ");
+			series.bucket_indices.push_back(ByteSizeHistogram::BucketIndex(bytes, histogram.Prefix()));
+
+		}
+
+		series.bucket_prefixes.push_back(bucket_name + "+Inf\"} ");
+
+		std::string braced_labels = label_string.empty() ? std::string() : "{" + label_string + "}";
+
+		series.count_prefix = family.name + "_count" + braced_labels + " ";
+		series.sum_prefix = family.name + "_sum" + braced_labels + " ";
+
+		family.series.push_back(std::move(series));
+
+	}
+
+	BYTESIZE_INLINE std::string_view MetricsExporter::Render() {
+
+		_buffer.clear();
+
+		for (const Family& family : _families) {
+
+			// Read the value before the HELP line, so that the line can show it and the sample is the same value.
+			bool annotate = _annotate_help && family.type != MetricType::Histogram && family.series.size() == 1;
+			ByteSize value = annotate ? family.series.front().source() : ByteSize(0);
+
+			if (!family.help.empty() || annotate) {
+
+				_buffer += "# HELP ";
+				_buffer += family.name;
+				_buffer += ' ';
+				_buffer += family.help;
+
+				if (annotate) {
+
+					char string[64];
+					std::to_chars_result result = value.ToChars(string, string + sizeof(string));
+
+					_buffer += family.help.empty() ? "(" : " (";
+					_buffer.append(string, result.ptr);
+					_buffer += ')';
+
+				}
+
+				_buffer += '\n';
+
+			}
+
+			_buffer += family.metadata;
+
+			for (const Series& series : family.series)
+				RenderSeries(family, series, annotate ? &value : nullptr);
+
+		}
+
+		_buffer += "# EOF\n";
+
+		return _buffer;
+
+	}
+
+	BYTESIZE_INLINE std::vector<ByteSize> MetricsExporter::DefaultBoundaries() {
+
+		std::vector<ByteSize> boundaries;
+
+		for (std::uint64_t bytes = 1024; bytes <= (std::uint64_t(1) << 30); bytes *= 4)
+			boundaries.push_back(ByteSize(bytes));
+
+		return boundaries;
+
+	}
+
+	BYTESIZE_INLINE MetricsExporter::Family& MetricsExporter::GetFamily(std::string_view name, MetricType type, std::string_view help) {
+
+		if (!IsValidName(name, false))
+			throw std::invalid_argument("Invalid metric name: " + std::string(name));
+
+		std::string family_name = std::string(name) + "_bytes";
+
+		for (Family& family : _families) {
+
+			if (family.name != family_name)
+				continue;
+
+			if (family.type != type)
+				throw std::invalid_argument("The metric " + family_name + " was already added with a different type.");
+
+			if (family.help.empty())
+				AppendEscaped(family.help, help);
+
+			return family;
+
+		}
+
+		static const char* const TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+
+		Family family;
+
+		family.name = family_name;
+		family.type = type;
+		family.metadata = "# TYPE " + family_name + " " + TYPE_NAMES[static_cast<int>(type)] + "\n# UNIT " + family_name + " bytes\n";
+
+		AppendEscaped(family.help, help);
+
+		_families.push_back(std::move(family));
+
+		return _families.back();
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AddSeries(std::string_view name, MetricType type, Source source, const MetricLabels& labels, std::string_view help) {
+
+		std::string label_string = FormatLabels(labels);
+		Family& family = GetFamily(name, type, help);
+		Series series;
+
+		series.prefix = family.name + (type == MetricType::Counter ? "_total" : "") + (label_string.empty() ? std::string() : "{" + label_string + "}") + " ";
+		series.source = std::move(source);
+		series.histogram = nullptr;
+
+		family.series.push_back(std::move(series));
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::RenderSeries(const Family& family, const Series& series, const ByteSize* value) {
+
+		if (family.type != MetricType::Histogram) {
+
+			_buffer += series.prefix;
+
+			AppendBytes(value != nullptr ? value->ExactBits() : series.source().ExactBits());
+
+			_buffer += '\n';
+
+			return;
+
+		}
+
+		// Bucket samples are cumulative, so the histogram's buckets are summed once, in order.
+		const ByteSizeHistogram& histogram = *series.histogram;
+		std::uint64_t cumulative = 0;
+		std::size_t next_bucket = 0;
+
+		for (std::size_t i = 0; i < series.bucket_indices.size(); ++i) {
+
+			for (; next_bucket <= series.bucket_indices[i]; ++next_bucket)
+				cumulative += histogram.CountInBucket(next_bucket);
+
+			_buffer += series.bucket_prefixes[i];
+
+			AppendCount(cumulative);
+
+			_buffer += '\n';
+
+		}
+
+		_buffer += series.bucket_prefixes.back();
+
+		AppendCount(histogram.Count());
+
+		_buffer += '\n';
+		_buffer += series.count_prefix;
+
+		AppendCount(histogram.Count());
+
+		_buffer += '\n';
+		_buffer += series.sum_prefix;
+
+		AppendBytes(histogram.Sum().ExactBits());
+
+		_buffer += '\n';
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AppendBytes(BitCount bits) {
+
+		char string[32];
+		char* position = string;
+		UnsignedBitCount magnitude = bits < 0 ? UnsignedBitCount(0) - static_cast<UnsignedBitCount>(bits) : static_cast<UnsignedBitCount>(bits);
+		UnsignedBitCount bytes = magnitude / 8;
+
+		if (bits < 0)
+			*position++ = '-';
+
+		position = std::to_chars(position, string + sizeof(string), static_cast<std::uint64_t>(bytes > UINT64_MAX ? UINT64_MAX : bytes)).ptr;
+
+		// A partial byte is a multiple of 0.125.
+		if (magnitude % 8 != 0) {
+
+			*position++ = '.';
+			position = std::to_chars(position, string + sizeof(string), static_cast<unsigned int>(magnitude % 8) * 125).ptr;
+
+		}
+
+		_buffer.append(string, position);
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AppendCount(std::uint64_t count) {
+
+		char string[24];
+
+		_buffer.append(string, std::to_chars(string, string + sizeof(string), count).ptr);
+
+	}
+
+	BYTESIZE_INLINE std::string MetricsExporter::FormatLabels(const MetricLabels& labels) {
+
+		std::string string;
+
+		for (const std::pair<std::string, std::string>& label : labels) {
+
+			if (!IsValidName(label.first, true))
+				throw std::invalid_argument("Invalid label name: " + label.first);
+
+			if (!string.empty())
+				string += ',';
+
+			string += label.first;
+			string += "=\"";
+
+			AppendEscaped(string, label.second);
+
+			string += '"';
+
+		}
+
+		return string;
+
+	}
+	BYTESIZE_INLINE bool MetricsExporter::IsValidName(std::string_view name, bool label) {
+
+		// Metric names may also contain colons; label names may not.
+		if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+			return false;
+
+		for (char c : name)
+			if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || (c == ':' && !label)))
+				return false;
+
+		return true;
+
+	}
+	BYTESIZE_INLINE void MetricsExporter::AppendEscaped(std::string& string, std::string_view value) {
+
+		for (char c : value) {
+
+			if (c == '\\' || c == '"')
+				string += '\\';
+
+			if (c == '\n')
+				string += "\\n";
+			else
+				string += c;
+
+		}
+
+	}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "ByteSize.h"
+#include "ByteSizeHistogram.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hvn3 {
+
+	typedef std::vector<std::pair<std::string, std::string>> MetricLabels;
+
+	// Renders size metrics in the OpenMetrics text format, for Prometheus and compatible scrapers.
+	// Each metric family is named after what it measures (e.g. "cache_size"), and "_bytes" is appended as the format requires. Samples hold
+	// raw byte counts. Optionally, the HELP line of a counter or gauge family with a single series also shows the value as ToString would
+	// (e.g. "(1.50 MiB)").
+	// Everything that doesn't change between scrapes, such as the metadata lines and each series' name and labels, is formatted when the
+	// metric is added. Render then only appends these and the numbers to a buffer that is reused, so it doesn't allocate once the buffer
+	// has grown large enough.
+	// Adding metrics and rendering are not synchronized with each other.
+	class MetricsExporter {
+
+	public:
+		// Returns the current value of a counter or gauge. Called on every Render.
+		typedef std::function<ByteSize()> Source;
+
+		explicit MetricsExporter(bool annotateHelp = false);
+
+		// Series of the same family must be added with the same type. Throws std::invalid_argument if a name is not a valid metric or label
+		// name, or the family already has a different type.
+		void AddCounter(std::string_view name, Source source, const MetricLabels& labels = MetricLabels(), std::string_view help = std::string_view());
+		void AddGauge(std::string_view name, Source source, const MetricLabels& labels = MetricLabels(), std::string_view help = std::string_view());
+		// The histogram is read on every Render, and must not be written to at the same time. Each boundary's bucket counts the sizes in the
+		// histogram buckets up to the one holding the boundary, so it is accurate to within the width of a histogram bucket.
+		void AddHistogram(std::string_view name, const ByteSizeHistogram& histogram, const std::vector<ByteSize>& boundaries = DefaultBoundaries(), const MetricLabels& labels = MetricLabels(), std::string_view help = std::string_view());
+
+		// Renders every metric, ending with "# EOF". The result is valid until the next call.
+		std::string_view Render();
+
+		// Returns 1 KiB, 4 KiB, 16 KiB and so on up to 1 GiB.
+		static std::vector<ByteSize> DefaultBoundaries();
+
+	private:
+		enum class MetricType {
+			Counter,
+			Gauge,
+			Histogram
+		};
+
+		struct Series {
+			// Everything before the value: the sample name, the labels and a space.
+			std::string prefix;
+			Source source;
+			const ByteSizeHistogram* histogram;
+			// For histograms, the prefixes of each boundary's bucket sample, followed by the "+Inf" bucket, count and sum samples.
+			std::vector<std::string> bucket_prefixes;
+			std::vector<std::size_t> bucket_indices;
+			std::string count_prefix;
+			std::string sum_prefix;
+		};
+
+		struct Family {
+			std::string name;
+			MetricType type;
+			std::string help;
+			// The TYPE and UNIT lines.
+			std::string metadata;
+			std::vector<Series> series;
+		};
+
+		Family& GetFamily(std::string_view name, MetricType type, std::string_view help);
+		void AddSeries(std::string_view name, MetricType type, Source source, const MetricLabels& labels, std::string_view help);
+		void RenderSeries(const Family& family, const Series& series, const ByteSize* value);
+		void AppendBytes(BitCount bits);
+		void AppendCount(std::uint64_t count);
+
+		static std::string FormatLabels(const MetricLabels& labels);
+		static bool IsValidName(std::string_view name, bool label);
+		static void AppendEscaped(std::string& string, std::string_view value);
+
+		bool _annotate_help;
+		std::vector<Family> _families;
+		std::string _buffer;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "MetricsExporter.cc"
+#endif
@@ -0,0 +1,364 @@
+#include "NetworkSampler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE NetworkSampler::NetworkSampler() :
+		_all_interfaces(true),
+		_file(-1),
+		_buffer(16384),
+		_has_sampled(false) {
+
+#if defined(__linux__)
+		_file = open("/proc/net/dev", O_RDONLY | O_CLOEXEC);
+#endif
+
+	}
+	BYTESIZE_INLINE NetworkSampler::NetworkSampler(const std::vector<std::string>& interfaces) :
+		_all_interfaces(false),
+		_file(-1),
+		_has_sampled(false) {
+
+		for (const std::string& name : interfaces) {
+
+			InterfaceSample sample;
+
+			sample.name = name;
+
+			_samples.push_back(sample);
+			_states.push_back(InterfaceState());
+
+			std::fill(std::begin(_states.back().files), std::end(_states.back().files), -1);
+
+			OpenFiles(_states.size() - 1);
+
+		}
+
+	}
+	BYTESIZE_INLINE NetworkSampler::~NetworkSampler() {
+
+#if defined(__linux__)
+		if (_file >= 0)
+			close(_file);
+#endif
+
+		for (std::size_t i = 0; i < _states.size(); ++i)
+			CloseFiles(i);
+
+	}
+
+	BYTESIZE_INLINE const std::vector<InterfaceSample>& NetworkSampler::Sample(clock::time_point now) {
+
+		double seconds = _has_sampled ? std::chrono::duration<double>(now - _last_sample).count() : 0.0;
+
+		if (_all_interfaces)
+			SampleProcNetDev(seconds);
+		else
+			SampleSysClassNet(seconds);
+
+		_last_sample = now;
+		_has_sampled = true;
+
+		return _samples;
+
+	}
+	BYTESIZE_INLINE const std::vector<InterfaceSample>& NetworkSampler::Interfaces() const {
+
+		return _samples;
+
+	}
+	BYTESIZE_INLINE const InterfaceSample* NetworkSampler::Find(std::string_view name) const {
+
+		for (const InterfaceSample& sample : _samples)
+			if (sample.name == name)
+				return &sample;
+
+		return nullptr;
+
+	}
+
+	BYTESIZE_INLINE void NetworkSampler::SampleProcNetDev(double seconds) {
+
+		std::size_t count = 0;
+
+#if defined(__linux__)
+
+		// Read the whole file, growing the buffer if it fills up (when interfaces are added).
+		while (_file >= 0) {
+
+			ssize_t result = pread(_file, _buffer.data(), _buffer.size(), 0);
+
+			if (result <= 0)
+				break;
+
+			count = static_cast<std::size_t>(result);
+
+			if (count < _buffer.size())
+				break;
+
+			_buffer.resize(_buffer.size() * 2);
+
+		}
+
+#endif
+
+		for (InterfaceState& state : _states)
+			state.seen = false;
+
+		const char* first = _buffer.data();
+		const char* last = first + count;
+		std::size_t expected_index = 0;
+
+		// After two header lines, each line is "<name>: " followed by 8 receive counters and 8 transmit counters, starting with the
+		// bytes and packets.
+		for (int line_number = 0; first < last; ++line_number) {
+
+			const char* end = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+
+			if (end == nullptr)
+				end = last;
+
+			const char* colon = line_number >= 2 ? static_cast<const char*>(std::memchr(first, ':', static_cast<std::size_t>(end - first))) : nullptr;
+
+			if (colon != nullptr) {
+
+				const char* name_first = first;
+
+				while (name_first < colon && *name_first == ' ')
+					++name_first;
+
+				std::string_view name(name_first, static_cast<std::size_t>(colon - name_first));
+				std::uint64_t fields[16] = {};
+				const char* position = colon + 1;
+				bool valid = true;
+
+				for (std::uint64_t& field : fields) {
+
+					while (position < end && *position == ' ')
+						++position;
+
+					std::from_chars_result result = std::from_chars(position, end, field);
+
+					if (result.ec != std::errc()) {
+
+						valid = false;
+
+						break;
+
+					}
+
+					position = result.ptr;
+
+				}
+
+				if (valid) {
+
+					std::uint64_t counters[COUNTER_COUNT] = { fields[0], fields[1], fields[8], fields[9] };
+
+					// Interfaces are usually listed in the same order as last time, so try the next one first.
+					std::size_t index = expected_index;
+
+					if (index >= _samples.size() || _samples[index].name != name)
+						for (index = 0; index < _samples.size() && _samples[index].name != name; ++index) {
+						}
+
+					if (index == _samples.size()) {
+
+						InterfaceSample sample;
+
+						sample.name = std::string(name);
+
+						_samples.push_back(sample);
+						_states.push_back(InterfaceState());
+
+						std::fill(std::begin(_states.back().files), std::end(_states.back().files), -1);
+
+					}
+
+					Update(index, counters, seconds, true);
+
+					expected_index = index + 1;
+
+				}
+
+			}
+
+			first = end + 1;
+
+		}
+
+		// Remove the interfaces that have disappeared.
+		std::size_t kept = 0;
+
+		for (std::size_t i = 0; i < _states.size(); ++i) {
+
+			if (!_states[i].seen)
+				continue;
+
+			if (kept != i) {
+
+				std::swap(_samples[kept], _samples[i]);
+				_states[kept] = _states[i];
+
+			}
+
+			++kept;
+
+		}
+
+		_samples.resize(kept);
+		_states.resize(kept);
+
+	}
+	BYTESIZE_INLINE void NetworkSampler::SampleSysClassNet(double seconds) {
+
+		for (std::size_t i = 0; i < _states.size(); ++i) {
+
+			InterfaceState& state = _states[i];
+
+			// The files of an interface that was removed can't be read again even if it comes back, so they are reopened.
+			if (state.files[0] < 0)
+				OpenFiles(i);
+
+			std::uint64_t counters[COUNTER_COUNT] = {};
+			bool valid = state.files[0] >= 0;
+
+#if defined(__linux__)
+
+			for (std::size_t counter = 0; counter < COUNTER_COUNT && valid; ++counter) {
+
+				char buffer[32];
+				ssize_t count = pread(state.files[counter], buffer, sizeof(buffer), 0);
+
+				valid = count > 0 && std::from_chars(buffer, buffer + count, counters[counter]).ec == std::errc();
+
+			}
+
+#endif
+
+			if (valid) {
+
+				Update(i, counters, seconds, false);
+
+			}
+			else {
+
+				CloseFiles(i);
+
+				InterfaceSample& sample = _samples[i];
+
+				sample.present = false;
+				sample.received = BitSize(0);
+				sample.transmitted = BitSize(0);
+				sample.received_packets = 0;
+				sample.transmitted_packets = 0;
+				sample.receive_rate = BitRate();
+				sample.transmit_rate = BitRate();
+
+				state.has_counters = false;
+
+			}
+
+		}
+
+	}
+	BYTESIZE_INLINE void NetworkSampler::Update(std::size_t index, const std::uint64_t (&counters)[COUNTER_COUNT], double seconds, bool counters32Bit) {
+
+		InterfaceSample& sample = _samples[index];
+		InterfaceState& state = _states[index];
+		std::uint64_t deltas[COUNTER_COUNT] = {};
+
+		if (state.has_counters)
+			for (std::size_t i = 0; i < COUNTER_COUNT; ++i)
+				deltas[i] = CounterDelta(state.counters[i], counters[i], counters32Bit);
+
+		std::copy(std::begin(counters), std::end(counters), std::begin(state.counters));
+
+		state.has_counters = true;
+		state.seen = true;
+
+		sample.present = true;
+		sample.received = BitSize(deltas[static_cast<std::size_t>(Counter::ReceivedBytes)]);
+		sample.transmitted = BitSize(deltas[static_cast<std::size_t>(Counter::TransmittedBytes)]);
+		sample.received_packets = deltas[static_cast<std::size_t>(Counter::ReceivedPackets)];
+		sample.transmitted_packets = deltas[static_cast<std::size_t>(Counter::TransmittedPackets)];
+		sample.receive_rate = seconds > 0.0 ? BitRate::FromBytesPerSecond(sample.received.Bytes() / seconds) : BitRate();
+		sample.transmit_rate = seconds > 0.0 ? BitRate::FromBytesPerSecond(sample.transmitted.Bytes() / seconds) : BitRate();
+
+	}
+	BYTESIZE_INLINE void NetworkSampler::OpenFiles(std::size_t index) {
+
+#if defined(__linux__)
+
+		static const char* const COUNTER_FILES[COUNTER_COUNT] = { "rx_bytes", "rx_packets", "tx_bytes", "tx_packets" };
+
+		InterfaceState& state = _states[index];
+		const std::string& name = _samples[index].name;
+
+		// Interface names can't contain slashes, so this can't open anything outside of /sys/class/net.
+		if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..")
+			return;
+
+		for (std::size_t counter = 0; counter < COUNTER_COUNT; ++counter) {
+
+			char path[128];
+			int length = std::snprintf(path, sizeof(path), "/sys/class/net/%s/statistics/%s", name.c_str(), COUNTER_FILES[counter]);
+
+			state.files[counter] = length > 0 && static_cast<std::size_t>(length) < sizeof(path) ? open(path, O_RDONLY | O_CLOEXEC) : -1;
+
+			if (state.files[counter] < 0) {
+
+				CloseFiles(index);
+
+				return;
+
+			}
+
+		}
+
+#else
+
+		static_cast<void>(index);
+
+#endif
+
+	}
+	BYTESIZE_INLINE void NetworkSampler::CloseFiles(std::size_t index) {
+
+		for (int& file : _states[index].files) {
+
+#if defined(__linux__)
+			if (file >= 0)
+				close(file);
+#endif
+
+			file = -1;
+
+		}
+
+	}
+
+	BYTESIZE_INLINE std::uint64_t NetworkSampler::CounterDelta(std::uint64_t previous, std::uint64_t current, bool counters32Bit) {
+
+		if (current >= previous)
+			return current - previous;
+
+		// A 32-bit counter that wrapped around.
+		if (counters32Bit && previous <= UINT32_MAX && current <= UINT32_MAX)
+			return static_cast<std::uint32_t>(current - previous);
+
+		// Otherwise the counter was reset (e.g. by the driver or when the interface was recreated). How much was counted before the reset
+		// is unknown, so no traffic is reported rather than a guess.
+		return 0;
+
+	}
+
+}
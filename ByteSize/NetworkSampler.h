@@ -0,0 +1,98 @@
+#pragma once
+#include "BitSize.h"
+#include "Rate.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hvn3 {
+
+	// The traffic of one network interface since the previous sample.
+	struct InterfaceSample {
+		std::string name;
+		// False if the interface's counters could not be read (only for interfaces named when the sampler was created).
+		bool present = false;
+		BitSize received{ 0 };
+		BitSize transmitted{ 0 };
+		std::uint64_t received_packets = 0;
+		std::uint64_t transmitted_packets = 0;
+		BitRate receive_rate;
+		BitRate transmit_rate;
+	};
+
+	// Samples the traffic of network interfaces on Linux, and reports the change and rate since the previous sample. Meant to be polled
+	// frequently (e.g. every 100 ms) on hosts with many interfaces: the files are kept open and reread with pread, and parsing doesn't
+	// allocate once every interface has been seen.
+	// The first sample of an interface reports no traffic. Counters in /proc/net/dev that go backwards are taken to have wrapped around if
+	// both values fit in 32 bits (as some drivers report them). Otherwise, and always for the 64-bit counters in /sys/class/net, the counter
+	// is taken to have been reset, and no traffic is reported for that sample.
+	// A sampler must not be used by more than one thread at a time. On other platforms, there are no interfaces.
+	class NetworkSampler {
+
+	public:
+		typedef std::chrono::steady_clock clock;
+
+		// Samples every interface listed in /proc/net/dev. Interfaces that appear are added to the samples, and those that disappear are
+		// removed.
+		NetworkSampler();
+		// Samples only the named interfaces, from /sys/class/net/<name>/statistics. Interfaces stay in the samples in the order given while
+		// they are missing, and are picked up again when they reappear.
+		explicit NetworkSampler(const std::vector<std::string>& interfaces);
+		NetworkSampler(const NetworkSampler&) = delete;
+		~NetworkSampler();
+
+		// Rereads the counters and returns the samples, which stay valid until the next call.
+		const std::vector<InterfaceSample>& Sample(clock::time_point now = clock::now());
+		// Returns the samples taken by the last call to Sample.
+		const std::vector<InterfaceSample>& Interfaces() const;
+		// Returns the last sample of the named interface, or nullptr if there is none.
+		const InterfaceSample* Find(std::string_view name) const;
+
+		NetworkSampler& operator=(const NetworkSampler&) = delete;
+
+	private:
+		enum class Counter {
+			ReceivedBytes,
+			ReceivedPackets,
+			TransmittedBytes,
+			TransmittedPackets,
+			Count
+		};
+
+		static constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::Count);
+
+		struct InterfaceState {
+			std::uint64_t counters[COUNTER_COUNT];
+			bool has_counters;
+			bool seen;
+			// Statistics files in /sys/class/net, or -1 if they are not open.
+			int files[COUNTER_COUNT];
+		};
+
+		void SampleProcNetDev(double seconds);
+		void SampleSysClassNet(double seconds);
+		// counters32Bit is true if the counters may be 32-bit values that wrap around.
+		void Update(std::size_t index, const std::uint64_t (&counters)[COUNTER_COUNT], double seconds, bool counters32Bit);
+		void OpenFiles(std::size_t index);
+		void CloseFiles(std::size_t index);
+
+		static std::uint64_t CounterDelta(std::uint64_t previous, std::uint64_t current, bool counters32Bit);
+
+		bool _all_interfaces;
+		int _file;
+		std::vector<char> _buffer;
+		std::vector<InterfaceSample> _samples;
+		std::vector<InterfaceState> _states;
+		clock::time_point _last_sample;
+		bool _has_sampled;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "NetworkSampler.cc"
+#endif
@@ -0,0 +1,10 @@
+#include "Rate.h"
+
+namespace hvn3 {
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	template class BasicRate<ByteTraits>;
+	template class BasicRate<BitTraits>;
+#endif
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace hvn3 {
+
+	// A quantity per second, displayed with the same unit ladder as BasicSize<Traits, PrefixPolicy> ("850.00 MiB/s", "12.40 Gbit/s").
+	// Unlike sizes, rates are not whole numbers of bits, so they are stored as a double.
+	template <typename Traits, typename PrefixPolicy = DynamicPrefix>
+	class BasicRate :
+		private PrefixPolicy {
+
+	public:
+		typedef BasicSize<Traits, PrefixPolicy> size_type;
+
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixPolicy::DEFAULT_PREFIX;
+
+		constexpr BasicRate(double bytesPerSecond = 0.0, BytePrefix prefix = DEFAULT_PREFIX);
+		constexpr BasicRate(double bytesPerSecond, BytePrefix prefix, ByteUnit unit);
+		// The rate at which size is transferred over duration.
+		template <typename Rep, typename Period>
+		BasicRate(const size_type& size, const std::chrono::duration<Rep, Period>& duration) :
+			BasicRate(size.Bytes() / std::chrono::duration<double>(duration).count(), size.Prefix(), size.Unit()) {
+		}
+		template <typename OtherTraits, typename OtherPrefixPolicy>
+		explicit BasicRate(const BasicRate<OtherTraits, OtherPrefixPolicy>& other);
+
+		constexpr BytePrefix Prefix() const;
+		constexpr ByteUnit Unit() const;
+
+		constexpr double BitsPerSecond() const;
+		constexpr double BytesPerSecond() const;
+		constexpr double UnitsPerSecond(int magnitude) const;
+
+		// Returns the size transferred over duration at this rate.
+		template <typename Rep, typename Period>
+		size_type SizeOver(const std::chrono::duration<Rep, Period>& duration) const {
+			return size_type::FromBits(BitsPerSecond() * std::chrono::duration<double>(duration).count(), Prefix());
+		}
+
+		// Returns the largest unit in which the rate is at least one per second, with the rate in that unit and the unit's symbol.
+		UnitSelection LargestUnit() const;
+
+		std::string ToString(unsigned int precision = 2) const;
+		std::to_chars_result ToChars(char* first, char* last, unsigned int precision = 2) const;
+
+		// Parses a rate such as "200 MiB/s", "10 Gbit/sec" or "100 Mbps". The size is parsed like BasicSize::Parse.
+		static constexpr BasicRate Parse(std::string_view string);
+		static constexpr ParseResult TryParse(std::string_view string, BasicRate& object);
+
+		static constexpr BasicRate FromBitsPerSecond(double rate, BytePrefix prefix = DEFAULT_PREFIX);
+		static constexpr BasicRate FromBytesPerSecond(double rate, BytePrefix prefix = DEFAULT_PREFIX);
+		static constexpr BasicRate FromUnitsPerSecond(int magnitude, double rate, BytePrefix prefix = DEFAULT_PREFIX);
+
+		BasicRate& operator+=(const BasicRate& rhs);
+		BasicRate& operator-=(const BasicRate& rhs);
+
+	private:
+		struct BitsTag {};
+
+		constexpr BasicRate(BitsTag, double bitsPerSecond, BytePrefix prefix, ByteUnit unit);
+
+		static constexpr ByteUnit DefaultUnit(BytePrefix prefix);
+
+		double _bits_per_second;
+
+	};
+
+	template <typename Traits, typename PrefixPolicy>
+	bool operator==(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	bool operator!=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	bool operator<(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	bool operator<=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	bool operator>(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	bool operator>=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	BasicRate<Traits, PrefixPolicy> operator+(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	BasicRate<Traits, PrefixPolicy> operator-(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+	template <typename Traits, typename PrefixPolicy>
+	std::ostream& operator<<(std::ostream& lhs, const BasicRate<Traits, PrefixPolicy>& rhs);
+
+	// Removes a per-second suffix ("/s", "/sec" or "ps", as in "Mbps") from the end of a rate, ignoring trailing whitespace.
+	// Returns false if there is none.
+	constexpr bool RemoveRateSuffix(std::string_view& string);
+
+	using ByteRate = BasicRate<ByteTraits>;
+	using BitRate = BasicRate<BitTraits>;
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	extern template class BasicRate<ByteTraits>;
+	extern template class BasicRate<BitTraits>;
+#endif
+
+}
+
+#include "Rate.inl"
@@ -0,0 +1,286 @@
+#pragma once
+#include <cfloat>
+#include <ostream>
+#include <stdexcept>
+
+namespace hvn3 {
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy>::BasicRate(double bytesPerSecond, BytePrefix prefix) :
+		BasicRate(bytesPerSecond, prefix, DefaultUnit(prefix)) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy>::BasicRate(double bytesPerSecond, BytePrefix prefix, ByteUnit unit) :
+		BasicRate(BitsTag(), bytesPerSecond * 8.0, prefix, unit) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	template <typename OtherTraits, typename OtherPrefixPolicy>
+	BasicRate<Traits, PrefixPolicy>::BasicRate(const BasicRate<OtherTraits, OtherPrefixPolicy>& other) :
+		BasicRate(BitsTag(), other.BitsPerSecond(), other.Prefix(), other.Unit()) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy>::BasicRate(BitsTag, double bitsPerSecond, BytePrefix prefix, ByteUnit unit) :
+		PrefixPolicy(prefix, unit),
+		_bits_per_second(bitsPerSecond) {
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BytePrefix BasicRate<Traits, PrefixPolicy>::Prefix() const {
+
+		return PrefixPolicy::Prefix();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ByteUnit BasicRate<Traits, PrefixPolicy>::Unit() const {
+
+		return PrefixPolicy::Unit();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicRate<Traits, PrefixPolicy>::BitsPerSecond() const {
+
+		return _bits_per_second;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicRate<Traits, PrefixPolicy>::BytesPerSecond() const {
+
+		return _bits_per_second / 8.0;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr double BasicRate<Traits, PrefixPolicy>::UnitsPerSecond(int magnitude) const {
+
+		return BytesPerSecond() / size_type::BytesInUnit(magnitude, Prefix());
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	UnitSelection BasicRate<Traits, PrefixPolicy>::LargestUnit() const {
+
+		// Select the unit from the whole number of bits, then scale the exact rate.
+		double bits = _bits_per_second;
+		BitCount whole_bits = !(bits == bits) ? 0 :
+			bits >= static_cast<double>(MaxBitCount()) ? MaxBitCount() :
+			bits <= static_cast<double>(MinBitCount()) ? MinBitCount() :
+			static_cast<BitCount>(bits);
+
+		UnitSelection selection = SelectUnit<Traits::BITS_IN_UNIT>(whole_bits, Prefix());
+
+		if (selection.magnitude < 0) {
+
+			selection.value = bits;
+			selection.symbol = BIT_SYMBOL;
+
+		}
+		else {
+
+			selection.value = bits / (UNIT_MULTIPLIERS[static_cast<int>(Prefix())][selection.magnitude] * Traits::BITS_IN_UNIT);
+			selection.symbol = Traits::SYMBOLS[static_cast<int>(Unit())][selection.magnitude];
+
+		}
+
+		return selection;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	std::string BasicRate<Traits, PrefixPolicy>::ToString(unsigned int precision) const {
+
+		char buffer[64];
+		std::to_chars_result result = ToChars(buffer, buffer + sizeof(buffer), precision);
+
+		if (result.ec == std::errc())
+			return std::string(buffer, result.ptr);
+
+		// Only very large values or precisions get here, so size the buffer for the worst case.
+		std::string string(DBL_MAX_10_EXP + precision + 24, '\0');
+
+		result = ToChars(&string[0], &string[0] + string.size(), precision);
+		string.resize(result.ptr - string.data());
+
+		return string;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::to_chars_result BasicRate<Traits, PrefixPolicy>::ToChars(char* first, char* last, unsigned int precision) const {
+
+		UnitSelection unit = LargestUnit();
+		std::to_chars_result result = FormatSize(first, last, unit.value, unit.symbol, precision);
+
+		if (result.ec != std::errc())
+			return result;
+
+		if (last - result.ptr < 2)
+			return { last, std::errc::value_too_large };
+
+		*result.ptr++ = '/';
+		*result.ptr++ = 's';
+
+		return result;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy> BasicRate<Traits, PrefixPolicy>::Parse(std::string_view string) {
+
+		BasicRate object;
+
+		if (!TryParse(string, object))
+			throw std::invalid_argument("The input string was not in the correct format.");
+
+		return object;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ParseResult BasicRate<Traits, PrefixPolicy>::TryParse(std::string_view string, BasicRate& object) {
+
+		std::string_view size_string = string;
+
+		if (!RemoveRateSuffix(size_string))
+			return { ParseError::InvalidSuffix, size_string.size() };
+
+		ParsedSize size{};
+		ParseResult result = ParseSize(size_string, size_type::BytesInUnit(0), size);
+
+		// The size is a prefix of the string, so error positions need no adjustment.
+		if (!result)
+			return result;
+
+		object = BasicRate(size.bytes, size.prefix, size.unit);
+
+		return { ParseError::None, string.size() };
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy> BasicRate<Traits, PrefixPolicy>::FromBitsPerSecond(double rate, BytePrefix prefix) {
+
+		return BasicRate(BitsTag(), rate, prefix, DefaultUnit(prefix));
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy> BasicRate<Traits, PrefixPolicy>::FromBytesPerSecond(double rate, BytePrefix prefix) {
+
+		return BasicRate(rate, prefix);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	constexpr BasicRate<Traits, PrefixPolicy> BasicRate<Traits, PrefixPolicy>::FromUnitsPerSecond(int magnitude, double rate, BytePrefix prefix) {
+
+		return BasicRate(rate * size_type::BytesInUnit(magnitude, prefix), prefix);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicRate<Traits, PrefixPolicy>& BasicRate<Traits, PrefixPolicy>::operator+=(const BasicRate& rhs) {
+
+		_bits_per_second += rhs._bits_per_second;
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicRate<Traits, PrefixPolicy>& BasicRate<Traits, PrefixPolicy>::operator-=(const BasicRate& rhs) {
+
+		_bits_per_second -= rhs._bits_per_second;
+
+		return *this;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	constexpr ByteUnit BasicRate<Traits, PrefixPolicy>::DefaultUnit(BytePrefix prefix) {
+
+		return prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator==(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return lhs.BitsPerSecond() == rhs.BitsPerSecond();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator!=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return !(lhs == rhs);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator<(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return lhs.BitsPerSecond() < rhs.BitsPerSecond();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator<=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return lhs.BitsPerSecond() <= rhs.BitsPerSecond();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator>(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return lhs.BitsPerSecond() > rhs.BitsPerSecond();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool operator>=(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		return lhs.BitsPerSecond() >= rhs.BitsPerSecond();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicRate<Traits, PrefixPolicy> operator+(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		BasicRate<Traits, PrefixPolicy> result(lhs);
+
+		return result += rhs;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline BasicRate<Traits, PrefixPolicy> operator-(const BasicRate<Traits, PrefixPolicy>& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		BasicRate<Traits, PrefixPolicy> result(lhs);
+
+		return result -= rhs;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::ostream& operator<<(std::ostream& lhs, const BasicRate<Traits, PrefixPolicy>& rhs) {
+
+		char buffer[64];
+		std::to_chars_result result = rhs.ToChars(buffer, buffer + sizeof(buffer));
+
+		if (result.ec == std::errc())
+			return lhs << std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+
+		return lhs << rhs.ToString();
+
+	}
+
+	constexpr bool RemoveRateSuffix(std::string_view& string) {
+
+		while (!string.empty() && internal::IsSpace(string.back()))
+			string.remove_suffix(1);
+
+		for (std::string_view suffix : { std::string_view("/sec"), std::string_view("/s"), std::string_view("ps") }) {
+
+			if (string.size() >= suffix.size() && string.substr(string.size() - suffix.size()) == suffix) {
+
+				string.remove_suffix(suffix.size());
+
+				return true;
+
+			}
+
+		}
+
+		return false;
+
+	}
+
+}
@@ -0,0 +1,133 @@
+#include "RateLimiter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE RateLimiter::RateLimiter(double bitsPerSecond, BitCount burstBits, clock::time_point start) :
+		_start(start),
+		_nanoseconds_per_bit(NanosecondsPerBit(bitsPerSecond)),
+		_burst_bits(0.0),
+		_full_time(0) {
+
+		SetBurstBits(burstBits);
+
+	}
+
+	BYTESIZE_INLINE ByteSize RateLimiter::Available(clock::time_point now) const {
+
+		double nanoseconds_per_bit = _nanoseconds_per_bit.load(std::memory_order_relaxed);
+
+		if (nanoseconds_per_bit == 0.0)
+			return Burst();
+
+		// The bucket is short of full by however long it will take to refill.
+		std::int64_t now_nanoseconds = Nanoseconds(now);
+		std::int64_t refill_time = (std::max)(_full_time.load(std::memory_order_relaxed), now_nanoseconds) - now_nanoseconds;
+		double bits = _burst_bits.load(std::memory_order_relaxed) - static_cast<double>(refill_time) / nanoseconds_per_bit;
+
+		return ByteSize::FromBits((std::max)(bits, 0.0));
+
+	}
+
+	BYTESIZE_INLINE ByteRate RateLimiter::Rate() const {
+
+		return ByteRate::FromBitsPerSecond(1e9 / _nanoseconds_per_bit.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE ByteSize RateLimiter::Burst() const {
+
+		return ByteSize::FromBits(_burst_bits.load(std::memory_order_relaxed));
+
+	}
+
+	BYTESIZE_INLINE RateLimiter::clock::duration RateLimiter::AcquireBits(BitCount bits, std::int64_t timeout, clock::time_point now) {
+
+		// Nothing else is published through the limiter, so relaxed ordering is enough.
+		double nanoseconds_per_bit = _nanoseconds_per_bit.load(std::memory_order_relaxed);
+		std::int64_t cost = NanosecondsFor(static_cast<double>(bits) * nanoseconds_per_bit);
+		std::int64_t burst = NanosecondsFor(_burst_bits.load(std::memory_order_relaxed) * nanoseconds_per_bit);
+		std::int64_t now_nanoseconds = Nanoseconds(now);
+		std::int64_t full_time = _full_time.load(std::memory_order_relaxed);
+
+		for (;;) {
+
+			// An idle bucket is full now, not at some time in the past.
+			std::int64_t start = (std::max)(full_time, now_nanoseconds);
+			std::int64_t new_full_time = cost > INT64_MAX - start ? INT64_MAX : start + cost;
+			// The bits are available once the bucket has refilled to within burst of full.
+			std::int64_t wait = new_full_time - burst - now_nanoseconds;
+
+			if (wait > timeout)
+				return clock::duration(-1);
+
+			if (_full_time.compare_exchange_weak(full_time, new_full_time, std::memory_order_relaxed))
+				return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds((std::max)(wait, std::int64_t(0))));
+
+		}
+
+	}
+	BYTESIZE_INLINE void RateLimiter::SetBitsPerSecond(double bitsPerSecond, clock::time_point now) {
+
+		double nanoseconds_per_bit = NanosecondsPerBit(bitsPerSecond);
+		double previous = _nanoseconds_per_bit.exchange(nanoseconds_per_bit, std::memory_order_relaxed);
+
+		// With an infinite rate, nothing is ever owed.
+		if (previous == nanoseconds_per_bit || previous == 0.0)
+			return;
+
+		std::int64_t now_nanoseconds = Nanoseconds(now);
+		std::int64_t full_time = _full_time.load(std::memory_order_relaxed);
+		double scale = nanoseconds_per_bit / previous;
+
+		while (full_time > now_nanoseconds && !_full_time.compare_exchange_weak(full_time, now_nanoseconds + NanosecondsFor(static_cast<double>(full_time - now_nanoseconds) * scale), std::memory_order_relaxed)) {
+		}
+
+	}
+	BYTESIZE_INLINE void RateLimiter::SetBurstBits(BitCount bits) {
+
+		if (bits < 0)
+			throw std::invalid_argument("The burst must not be negative.");
+
+		_burst_bits.store(static_cast<double>(bits), std::memory_order_relaxed);
+
+	}
+
+	BYTESIZE_INLINE std::int64_t RateLimiter::Nanoseconds(clock::time_point time) const {
+
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time - _start).count();
+
+	}
+
+	BYTESIZE_INLINE std::int64_t RateLimiter::NanosecondsFor(double nanoseconds) {
+
+		// Rounding up keeps many small acquisitions from adding up to more than the rate. The limit keeps sums of a few durations from
+		// overflowing, and is still over 70 years.
+		const double max_nanoseconds = static_cast<double>(INT64_MAX / 4);
+
+		return static_cast<std::int64_t>((std::min)(std::ceil((std::max)(nanoseconds, 0.0)), max_nanoseconds));
+
+	}
+	BYTESIZE_INLINE double RateLimiter::NanosecondsPerBit(double bitsPerSecond) {
+
+		if (!(bitsPerSecond > 0.0))
+			throw std::invalid_argument("The rate must be positive.");
+
+		return 1e9 / bitsPerSecond;
+
+	}
+	BYTESIZE_INLINE bool RateLimiter::SleepFor(clock::duration duration) {
+
+		if (duration < clock::duration::zero())
+			return false;
+
+		if (duration > clock::duration::zero())
+			std::this_thread::sleep_for(duration);
+
+		return true;
+
+	}
+
+}
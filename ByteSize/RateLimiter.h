@@ -0,0 +1,114 @@
+#pragma once
+#include "AtomicSize.h"
+#include "Rate.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace hvn3 {
+
+	// Limits the rate at which bytes (or bits) are let through a code path, e.g. to throttle replication or backup traffic to "200 MiB/s".
+	// It behaves like a token bucket that holds up to burst, refilled at rate: after being idle, up to burst can be acquired at once, and
+	// after that, acquisitions are spaced out to keep to the rate.
+	// The bucket is kept as a single atomic time, the time at which it will be full again (the generic cell rate algorithm), so any number
+	// of threads can acquire without taking a lock. The rate and burst can be changed from any thread while others acquire.
+	class RateLimiter {
+
+	public:
+		typedef std::chrono::steady_clock clock;
+
+		// Throws std::invalid_argument if the rate is not positive or the burst is negative. An infinite rate lets everything through.
+		template <typename Traits, typename PrefixPolicy, typename SizeTraits, typename SizePrefixPolicy>
+		RateLimiter(const BasicRate<Traits, PrefixPolicy>& rate, const BasicSize<SizeTraits, SizePrefixPolicy>& burst, clock::time_point start = clock::now()) :
+			RateLimiter(rate.BitsPerSecond(), burst.ExactBits(), start) {
+		}
+		RateLimiter(const RateLimiter&) = delete;
+
+		// Acquires size if the bucket holds that much, and returns false without acquiring anything otherwise. A size larger than the burst
+		// can never be acquired this way.
+		template <typename Traits, typename PrefixPolicy>
+		bool TryAcquire(const BasicSize<Traits, PrefixPolicy>& size, clock::time_point now = clock::now()) {
+			return AcquireBits(size.ExactBits(), 0, now) >= clock::duration::zero();
+		}
+		// Acquires size if it becomes available within timeout, blocking until it does. Returns false at once otherwise.
+		template <typename Traits, typename PrefixPolicy, typename Rep, typename Period>
+		bool TryAcquireFor(const BasicSize<Traits, PrefixPolicy>& size, const std::chrono::duration<Rep, Period>& timeout) {
+			return SleepFor(AcquireBits(size.ExactBits(), TimeoutNanoseconds(timeout), clock::now()));
+		}
+		// Acquires size, blocking until it is available. Sizes larger than the burst can be acquired too, but even from a full bucket, the
+		// caller waits for the excess over the burst to refill (e.g. about 16 ms for 80 KiB at 1 MiB/s with a 64 KiB burst).
+		template <typename Traits, typename PrefixPolicy>
+		void Acquire(const BasicSize<Traits, PrefixPolicy>& size) {
+			SleepFor(Reserve(size));
+		}
+		// Acquires size without blocking, and returns how long to wait before using it (e.g. to schedule a timer instead of sleeping).
+		// The reservation cannot be cancelled.
+		template <typename Traits, typename PrefixPolicy>
+		clock::duration Reserve(const BasicSize<Traits, PrefixPolicy>& size, clock::time_point now = clock::now()) {
+			return AcquireBits(size.ExactBits(), INT64_MAX, now);
+		}
+
+		// Returns how much could be acquired now without waiting.
+		ByteSize Available(clock::time_point now = clock::now()) const;
+
+		ByteRate Rate() const;
+		ByteSize Burst() const;
+
+		// Takes effect for acquisitions that start after the call. The time that reservations already made leave the bucket in debt for is
+		// scaled to the new rate, so that raising the rate also shortens it.
+		template <typename Traits, typename PrefixPolicy>
+		void SetRate(const BasicRate<Traits, PrefixPolicy>& rate, clock::time_point now = clock::now()) {
+			SetBitsPerSecond(rate.BitsPerSecond(), now);
+		}
+		template <typename Traits, typename PrefixPolicy>
+		void SetBurst(const BasicSize<Traits, PrefixPolicy>& burst) {
+			SetBurstBits(burst.ExactBits());
+		}
+
+		RateLimiter& operator=(const RateLimiter&) = delete;
+
+	private:
+		RateLimiter(double bitsPerSecond, BitCount burstBits, clock::time_point start);
+
+		// Returns how long to wait for the bits to be available, or a negative duration if that is longer than timeout (in nanoseconds), in
+		// which case nothing is acquired.
+		clock::duration AcquireBits(BitCount bits, std::int64_t timeout, clock::time_point now);
+		void SetBitsPerSecond(double bitsPerSecond, clock::time_point now);
+		void SetBurstBits(BitCount bits);
+
+		std::int64_t Nanoseconds(clock::time_point time) const;
+
+		static std::int64_t NanosecondsFor(double nanoseconds);
+		// Converts the timeout to nanoseconds, clamped to the range of std::int64_t (e.g. for std::chrono::hours::max()).
+		template <typename Rep, typename Period>
+		static std::int64_t TimeoutNanoseconds(const std::chrono::duration<Rep, Period>& timeout) {
+
+			// Compared as a double, since converting a timeout that is out of range to nanoseconds would overflow.
+			double nanoseconds = std::chrono::duration<double, std::nano>(timeout).count();
+
+			if (nanoseconds >= static_cast<double>(INT64_MAX))
+				return INT64_MAX;
+
+			if (nanoseconds <= static_cast<double>(INT64_MIN))
+				return INT64_MIN;
+
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+
+		}
+		static double NanosecondsPerBit(double bitsPerSecond);
+		static bool SleepFor(clock::duration duration);
+
+		const clock::time_point _start;
+		std::atomic<double> _nanoseconds_per_bit;
+		std::atomic<double> _burst_bits;
+		// The time (in nanoseconds since _start) at which the bucket will be full, if nothing else is acquired. Every acquisition moves it
+		// forward by the time it takes to refill what was acquired. It has a cache line of its own, as it is written by every acquisition.
+		alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> _full_time;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "RateLimiter.cc"
+#endif
@@ -0,0 +1,310 @@
+#include "SharedCounters.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BYTESIZE_SHARED_MEMORY
+#endif
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE SharedCounterRegion::SharedCounterRegion(std::string name, std::size_t capacity) :
+		_name(std::move(name)),
+		_path("/dev/shm/" + _name),
+		_file(-1),
+		_mapping(nullptr),
+		_mapping_size(sizeof(internal::SharedCounterHeader) + capacity * sizeof(internal::SharedCounterEntry)),
+		_header(nullptr),
+		_entries(nullptr),
+		_update_depth(0) {
+
+		if (_name.empty() || _name.find('/') != std::string::npos || _name == "." || _name == "..")
+			throw std::invalid_argument("The region name must be a valid file name.");
+
+		if (capacity > UINT32_MAX)
+			throw std::invalid_argument("The region capacity is too large.");
+
+#if defined(BYTESIZE_SHARED_MEMORY)
+
+		// Replace any existing region rather than writing to a file that readers may have mapped with a different layout.
+		unlink(_path.c_str());
+
+		_file = open(_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+
+		if (_file < 0)
+			throw std::system_error(errno, std::generic_category(), "Failed to create " + _path);
+
+		if (ftruncate(_file, static_cast<off_t>(_mapping_size)) != 0 ||
+			(_mapping = mmap(nullptr, _mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, _file, 0)) == MAP_FAILED) {
+
+			int error = errno;
+
+			close(_file);
+			unlink(_path.c_str());
+
+			throw std::system_error(error, std::generic_category(), "Failed to map " + _path);
+
+		}
+
+		// The file is zero-filled, so only the fields that aren't zero need to be written. The magic number is written last, so readers that
+		// see it also see the rest of the header.
+		_header = static_cast<internal::SharedCounterHeader*>(_mapping);
+		_entries = reinterpret_cast<internal::SharedCounterEntry*>(_header + 1);
+
+		_header->version = internal::SHARED_COUNTERS_VERSION;
+		_header->capacity = static_cast<std::uint32_t>(capacity);
+		_header->magic.store(internal::SHARED_COUNTERS_MAGIC, std::memory_order_release);
+
+#else
+
+		throw std::runtime_error("Shared counters are not supported on this platform.");
+
+#endif
+
+	}
+	BYTESIZE_INLINE SharedCounterRegion::~SharedCounterRegion() {
+
+#if defined(BYTESIZE_SHARED_MEMORY)
+
+		munmap(_mapping, _mapping_size);
+		close(_file);
+		unlink(_path.c_str());
+
+#endif
+
+	}
+
+	BYTESIZE_INLINE const std::string& SharedCounterRegion::Name() const {
+
+		return _name;
+
+	}
+
+	BYTESIZE_INLINE std::size_t SharedCounterRegion::AddCounter(std::string_view name, const ByteSize& initialValue) {
+
+		return AddEntry(name, initialValue.ExactBits(), initialValue.Prefix(), initialValue.Unit(), false);
+
+	}
+	BYTESIZE_INLINE std::size_t SharedCounterRegion::AddCounter(std::string_view name, const BitSize& initialValue) {
+
+		return AddEntry(name, initialValue.ExactBits(), initialValue.Prefix(), initialValue.Unit(), true);
+
+	}
+
+	BYTESIZE_INLINE void SharedCounterRegion::BeginUpdate() {
+
+		if (_update_depth++ > 0)
+			return;
+
+		_header->sequence.store(_header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+		// Keeps the values from being written before the sequence number is.
+		std::atomic_thread_fence(std::memory_order_release);
+
+	}
+	BYTESIZE_INLINE void SharedCounterRegion::EndUpdate() {
+
+		if (--_update_depth > 0)
+			return;
+
+		_header->sequence.store(_header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+	}
+
+	BYTESIZE_INLINE void SharedCounterRegion::Set(std::size_t index, const ByteSize& value) {
+
+		Store(index, value.ExactBits(), false);
+
+	}
+	BYTESIZE_INLINE void SharedCounterRegion::Set(std::size_t index, const BitSize& value) {
+
+		Store(index, value.ExactBits(), false);
+
+	}
+	BYTESIZE_INLINE void SharedCounterRegion::Add(std::size_t index, const ByteSize& value) {
+
+		Store(index, value.ExactBits(), true);
+
+	}
+	BYTESIZE_INLINE void SharedCounterRegion::Add(std::size_t index, const BitSize& value) {
+
+		Store(index, value.ExactBits(), true);
+
+	}
+
+	BYTESIZE_INLINE std::size_t SharedCounterRegion::AddEntry(std::string_view name, BitCount bits, BytePrefix prefix, ByteUnit unit, bool bitCounter) {
+
+		std::uint32_t index = _header->count.load(std::memory_order_relaxed);
+
+		if (index >= _header->capacity)
+			throw std::length_error("The shared counter region is full.");
+
+		internal::SharedCounterEntry& entry = _entries[index];
+		std::size_t name_length = std::min(name.size(), internal::SHARED_COUNTER_NAME_SIZE - 1);
+
+		std::memcpy(entry.name, name.data(), name_length);
+
+		entry.name[name_length] = '\0';
+		entry.bit_counter = bitCounter ? 1 : 0;
+		entry.prefix = static_cast<std::uint8_t>(prefix);
+		entry.unit = static_cast<std::uint8_t>(unit);
+		entry.bits.store(static_cast<std::int64_t>(std::clamp<BitCount>(bits, INT64_MIN, INT64_MAX)), std::memory_order_relaxed);
+
+		// Publishes the entry.
+		_header->count.store(index + 1, std::memory_order_release);
+
+		return index;
+
+	}
+	BYTESIZE_INLINE void SharedCounterRegion::Store(std::size_t index, BitCount bits, bool add) {
+
+		std::atomic<std::int64_t>& value = _entries[index].bits;
+
+		if (add)
+			bits = SaturatingAdd(static_cast<BitCount>(value.load(std::memory_order_relaxed)), bits);
+
+		BeginUpdate();
+
+		value.store(static_cast<std::int64_t>(std::clamp<BitCount>(bits, INT64_MIN, INT64_MAX)), std::memory_order_relaxed);
+
+		EndUpdate();
+
+	}
+
+	BYTESIZE_INLINE std::string SharedCounter::ToString(unsigned int precision) const {
+
+		return bit_counter ? BitSize(value).ToString(precision) : value.ToString(precision);
+
+	}
+
+	BYTESIZE_INLINE SharedCounterReader::SharedCounterReader(const std::string& name) :
+		_file(-1),
+		_mapping(nullptr),
+		_mapping_size(0),
+		_header(nullptr),
+		_entries(nullptr) {
+
+#if defined(BYTESIZE_SHARED_MEMORY)
+
+		std::string path = "/dev/shm/" + name;
+
+		_file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (_file < 0)
+			throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+
+		struct stat status;
+
+		if (fstat(_file, &status) != 0 ||
+			(_mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, _file, 0)) == MAP_FAILED) {
+
+			int error = errno;
+
+			close(_file);
+
+			throw std::system_error(error, std::generic_category(), "Failed to map " + path);
+
+		}
+
+		_mapping_size = static_cast<std::size_t>(status.st_size);
+		_header = static_cast<const internal::SharedCounterHeader*>(_mapping);
+		_entries = reinterpret_cast<const internal::SharedCounterEntry*>(_header + 1);
+
+		if (_mapping_size < sizeof(internal::SharedCounterHeader) ||
+			_header->magic.load(std::memory_order_acquire) != internal::SHARED_COUNTERS_MAGIC ||
+			_header->version != internal::SHARED_COUNTERS_VERSION ||
+			_mapping_size < sizeof(internal::SharedCounterHeader) + std::size_t(_header->capacity) * sizeof(internal::SharedCounterEntry)) {
+
+			munmap(_mapping, _mapping_size);
+			close(_file);
+
+			throw std::runtime_error(path + " is not a shared counter region.");
+
+		}
+
+#else
+
+		static_cast<void>(name);
+
+		throw std::runtime_error("Shared counters are not supported on this platform.");
+
+#endif
+
+	}
+	BYTESIZE_INLINE SharedCounterReader::~SharedCounterReader() {
+
+#if defined(BYTESIZE_SHARED_MEMORY)
+
+		munmap(_mapping, _mapping_size);
+		close(_file);
+
+#endif
+
+	}
+
+	BYTESIZE_INLINE bool SharedCounterReader::TryRead(std::vector<SharedCounter>& counters) const {
+
+		for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+
+			std::uint64_t sequence = _header->sequence.load(std::memory_order_acquire);
+
+			if (sequence % 2 != 0) {
+
+				std::this_thread::yield();
+
+				continue;
+
+			}
+
+			std::size_t count = std::min(_header->count.load(std::memory_order_acquire), _header->capacity);
+
+			counters.resize(count, SharedCounter{ std::string(), false, ByteSize(0) });
+
+			for (std::size_t i = 0; i < count; ++i) {
+
+				const internal::SharedCounterEntry& entry = _entries[i];
+				BytePrefix prefix = entry.prefix == static_cast<std::uint8_t>(BytePrefix::Decimal) ? BytePrefix::Decimal : BytePrefix::Binary;
+				ByteUnit unit = entry.unit <= static_cast<std::uint8_t>(ByteUnit::JEDEC) ? static_cast<ByteUnit>(entry.unit) : ByteUnit::IEC;
+
+				// IEC units are only used with binary prefixes.
+				if (unit == ByteUnit::IEC)
+					prefix = BytePrefix::Binary;
+
+				counters[i].name.assign(entry.name, std::find(entry.name, entry.name + internal::SHARED_COUNTER_NAME_SIZE, '\0'));
+				counters[i].bit_counter = entry.bit_counter != 0;
+				counters[i].value = ByteSize(0, prefix, unit);
+				counters[i].value += ByteSize::FromExactBits(entry.bits.load(std::memory_order_relaxed), prefix);
+
+			}
+
+			// Keeps the values from being read after the sequence number is checked again.
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (_header->sequence.load(std::memory_order_relaxed) == sequence)
+				return true;
+
+		}
+
+		return false;
+
+	}
+	BYTESIZE_INLINE std::vector<SharedCounter> SharedCounterReader::Read() const {
+
+		std::vector<SharedCounter> counters;
+
+		if (!TryRead(counters))
+			throw std::runtime_error("The shared counters were being updated on every attempt to read them.");
+
+		return counters;
+
+	}
+
+}
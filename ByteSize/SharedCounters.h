@@ -0,0 +1,136 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hvn3 {
+
+	namespace internal {
+
+		// The layout of a shared counter region: a header followed by capacity entries. Both are 64 bytes, and the layout must not change
+		// without changing SHARED_COUNTERS_VERSION.
+		constexpr std::uint32_t SHARED_COUNTERS_MAGIC = 0x52435342; // "BSCR"
+		constexpr std::uint32_t SHARED_COUNTERS_VERSION = 1;
+		constexpr std::size_t SHARED_COUNTER_NAME_SIZE = 48;
+
+		struct SharedCounterHeader {
+			std::atomic<std::uint32_t> magic;
+			std::uint32_t version;
+			std::uint32_t capacity;
+			// Entries are published by incrementing count after they are written.
+			std::atomic<std::uint32_t> count;
+			// Odd while the writer is updating values.
+			std::atomic<std::uint64_t> sequence;
+			std::uint8_t reserved[40];
+		};
+
+		struct SharedCounterEntry {
+			// The exact number of bits.
+			std::atomic<std::int64_t> bits;
+			// 1 for a BitSize counter, 0 for a ByteSize counter.
+			std::uint8_t bit_counter;
+			std::uint8_t prefix;
+			std::uint8_t unit;
+			std::uint8_t reserved[5];
+			// Null-terminated, and truncated if needed.
+			char name[SHARED_COUNTER_NAME_SIZE];
+		};
+
+		static_assert(sizeof(SharedCounterHeader) == 64 && sizeof(SharedCounterEntry) == 64, "The shared counter layout is fixed.");
+		static_assert(std::atomic<std::int64_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free, "Shared counters require lock-free atomics.");
+
+	}
+
+	// A named group of size counters in a file under /dev/shm, which other processes can map and read (see SharedCounterReader) without
+	// communicating with the process that writes them.
+	// Counters are written by one thread at a time. Readers see the values written by a BeginUpdate/EndUpdate pair all together or not at
+	// all (like a seqlock); each Set or Add outside of a pair is its own update.
+	// Throws std::system_error if the region can't be created, and std::runtime_error on platforms without POSIX shared memory.
+	class SharedCounterRegion {
+
+	public:
+		// The name must be a valid file name. An existing region with the same name is replaced, and the region is removed when it is
+		// destroyed.
+		explicit SharedCounterRegion(std::string name, std::size_t capacity = 64);
+		SharedCounterRegion(const SharedCounterRegion&) = delete;
+		~SharedCounterRegion();
+
+		const std::string& Name() const;
+
+		// Adds a counter with the given initial value, and returns its index. Throws std::length_error if the region is full.
+		std::size_t AddCounter(std::string_view name, const ByteSize& initialValue = ByteSize(0));
+		std::size_t AddCounter(std::string_view name, const BitSize& initialValue);
+
+		void BeginUpdate();
+		void EndUpdate();
+
+		void Set(std::size_t index, const ByteSize& value);
+		void Set(std::size_t index, const BitSize& value);
+		void Add(std::size_t index, const ByteSize& value);
+		void Add(std::size_t index, const BitSize& value);
+
+		SharedCounterRegion& operator=(const SharedCounterRegion&) = delete;
+
+	private:
+		std::size_t AddEntry(std::string_view name, BitCount bits, BytePrefix prefix, ByteUnit unit, bool bitCounter);
+		void Store(std::size_t index, BitCount bits, bool add);
+
+		std::string _name;
+		std::string _path;
+		int _file;
+		void* _mapping;
+		std::size_t _mapping_size;
+		internal::SharedCounterHeader* _header;
+		internal::SharedCounterEntry* _entries;
+		unsigned int _update_depth;
+
+	};
+
+	struct SharedCounter {
+		std::string name;
+		bool bit_counter;
+		// BitSize counters are stored with the same bit count, prefix and unit.
+		ByteSize value;
+
+		// Formats the value with ByteSize::ToString or BitSize::ToString.
+		std::string ToString(unsigned int precision = 2) const;
+	};
+
+	// Maps a region created by SharedCounterRegion (possibly in another process) read-only, and reads consistent snapshots of its counters.
+	// Throws std::system_error if the region can't be opened, and std::runtime_error if it isn't a counter region.
+	class SharedCounterReader {
+
+	public:
+		explicit SharedCounterReader(const std::string& name);
+		SharedCounterReader(const SharedCounterReader&) = delete;
+		~SharedCounterReader();
+
+		// Reads every counter. Returns false if the writer was updating the counters every time they were read, for example because it
+		// stopped in the middle of an update.
+		bool TryRead(std::vector<SharedCounter>& counters) const;
+		// Like TryRead, but throws std::runtime_error instead of returning false.
+		std::vector<SharedCounter> Read() const;
+
+		SharedCounterReader& operator=(const SharedCounterReader&) = delete;
+
+	private:
+		static constexpr int MAX_READ_ATTEMPTS = 10000;
+
+		int _file;
+		void* _mapping;
+		std::size_t _mapping_size;
+		const internal::SharedCounterHeader* _header;
+		const internal::SharedCounterEntry* _entries;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "SharedCounters.cc"
+#endif
@@ -0,0 +1,123 @@
+#include "SizeArray.h"
+#include <algorithm>
+#include <thread>
+
+namespace hvn3 {
+
+	namespace internal {
+
+		// Smallest number of elements worth handing to another thread.
+		static const std::size_t MIN_ELEMENTS_PER_THREAD = std::size_t(1) << 16;
+		// Each count is summed as a signed high half and an unsigned low half. Blocks are small enough that neither sum can overflow within a
+		// block, and after each one, the low sum is carried into the high sum so that it stays below 2^HALF_BITS.
+		static const int HALF_BITS = sizeof(BitCount) * 4;
+		static const BitCount LOW_MASK = (BitCount(1) << HALF_BITS) - 1;
+
+		struct PartialTotals {
+			BitCount high;
+			BitCount low;
+			BitCount min;
+			BitCount max;
+		};
+
+		static void AddHalves(PartialTotals& totals, BitCount high, BitCount low) {
+
+			// Both low sums are non-negative, and the masked one is below 2^HALF_BITS, so adding it can't overflow.
+			totals.low += low & LOW_MASK;
+			totals.high = SaturatingAdd(totals.high, SaturatingAdd(high, (low >> HALF_BITS) + (totals.low >> HALF_BITS)));
+			totals.low &= LOW_MASK;
+
+		}
+		static PartialTotals ReduceRange(const BitCount* bits, std::size_t size, std::size_t blockSize) {
+
+			PartialTotals totals{ 0, 0, MaxBitCount(), MinBitCount() };
+
+			for (std::size_t first = 0; first < size; first += blockSize) {
+
+				std::size_t last = (std::min)(size, first + blockSize);
+				BitCount high = 0;
+				BitCount low = 0;
+				BitCount min = totals.min;
+				BitCount max = totals.max;
+
+				// Plain adds and selects, so the loop vectorizes.
+				for (std::size_t i = first; i < last; ++i) {
+
+					BitCount value = bits[i];
+
+					high += value >> HALF_BITS;
+					low += value & LOW_MASK;
+					min = value < min ? value : min;
+					max = value > max ? value : max;
+
+				}
+
+				AddHalves(totals, high, low);
+				totals.min = min;
+				totals.max = max;
+
+			}
+
+			return totals;
+
+		}
+
+		BYTESIZE_INLINE BitCountTotals ReduceBitCounts(const BitCount* bits, std::size_t size, std::size_t threadCount, std::size_t blockSize) {
+
+			if (size == 0)
+				return { 0, 0.0, 0, 0 };
+
+			std::size_t thread_count = (std::min)(threadCount == 0 ? HardwareConcurrency() : threadCount, (std::max)(std::size_t(1), size / MIN_ELEMENTS_PER_THREAD));
+			std::size_t chunk_size = (size + thread_count - 1) / thread_count;
+			std::vector<PartialTotals> partials(thread_count);
+			std::vector<std::thread> threads;
+
+			threads.reserve(thread_count - 1);
+
+			for (std::size_t i = 1; i < thread_count; ++i) {
+
+				std::size_t first = (std::min)(size, i * chunk_size);
+				std::size_t count = (std::min)(size - first, chunk_size);
+
+				threads.emplace_back([&partials, bits, i, first, count, blockSize] {
+					partials[i] = ReduceRange(bits + first, count, blockSize);
+				});
+
+			}
+
+			partials[0] = ReduceRange(bits, (std::min)(size, chunk_size), blockSize);
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			PartialTotals totals = partials[0];
+
+			for (std::size_t i = 1; i < thread_count; ++i) {
+
+				AddHalves(totals, partials[i].high, partials[i].low);
+				totals.min = (std::min)(totals.min, partials[i].min);
+				totals.max = (std::max)(totals.max, partials[i].max);
+
+			}
+
+			const double half_scale = static_cast<double>(BitCount(1) << HALF_BITS);
+
+			BitCountTotals result;
+
+			result.sum = SaturatingAdd(SaturatingMultiply(totals.high, BitCount(1) << HALF_BITS), totals.low);
+			result.mean = (static_cast<double>(totals.high) * half_scale + static_cast<double>(totals.low)) / static_cast<double>(size);
+			result.min = totals.min;
+			result.max = totals.max;
+
+			return result;
+
+		}
+
+	}
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	template class BasicSizeArray<ByteTraits>;
+	template class BasicSizeArray<BitTraits>;
+#endif
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <cstddef>
+#include <vector>
+
+namespace hvn3 {
+
+	namespace internal {
+
+		struct BitCountTotals {
+			BitCount sum;
+			double mean;
+			BitCount min;
+			BitCount max;
+		};
+
+		// Computes the sum, mean, minimum and maximum of the counts in one pass, splitting the work between threadCount threads.
+		// Each thread sums blockSize counts at a time before carrying into its total, which only needs changing to test the carries.
+		BitCountTotals ReduceBitCounts(const BitCount* bits, std::size_t size, std::size_t threadCount, std::size_t blockSize = std::size_t(1) << 30);
+
+	}
+
+	// A column of sizes that share one prefix and unit system, stored as a contiguous array of bit counts.
+	// Each element takes the size of a BitCount instead of a whole BasicSize, and bulk operations run over the array in loops that compilers
+	// can vectorize, so scans over millions of sizes are limited by memory bandwidth rather than per-object calls.
+	template <typename Traits, typename PrefixPolicy = DynamicPrefix>
+	class BasicSizeArray :
+		private PrefixPolicy {
+
+	public:
+		typedef BasicSize<Traits, PrefixPolicy> size_type;
+
+		static constexpr BytePrefix DEFAULT_PREFIX = PrefixPolicy::DEFAULT_PREFIX;
+
+		explicit BasicSizeArray(BytePrefix prefix = DEFAULT_PREFIX);
+		// Creates an array of size zero-sized elements.
+		explicit BasicSizeArray(std::size_t size, BytePrefix prefix = DEFAULT_PREFIX);
+
+		BytePrefix Prefix() const;
+		ByteUnit Unit() const;
+
+		std::size_t Size() const;
+		bool Empty() const;
+		void Reserve(std::size_t capacity);
+		void Resize(std::size_t size);
+		void Clear();
+
+		// Sizes with a different prefix are stored as they are, and take on the prefix of the array.
+		void PushBack(const size_type& size);
+		size_type Get(std::size_t index) const;
+		void Set(std::size_t index, const size_type& size);
+
+		// Returns the exact bit counts of the elements.
+		BitCount* Data();
+		const BitCount* Data() const;
+
+		// Writes the value of every element in the given unit to out, which must have room for Size() elements.
+		// Units(1, out) is the bulk equivalent of calling Kilobytes() (or Kilobits()) on each element, and so on.
+		void Bits(double* out) const;
+		void Bytes(double* out) const;
+		void Units(int magnitude, double* out) const;
+		std::vector<double> Units(int magnitude) const;
+
+		// Reductions over all elements. threadCount threads share the work on large arrays; zero uses one per hardware thread.
+		size_type Sum(std::size_t threadCount = 1) const;
+		size_type Mean(std::size_t threadCount = 1) const;
+		size_type Min(std::size_t threadCount = 1) const;
+		size_type Max(std::size_t threadCount = 1) const;
+
+		// Creates an array from sizes in bytes or units, rounding partial bits away from zero like RoundBytesToNearestBit.
+		static BasicSizeArray FromBytes(const double* sizes, std::size_t size, BytePrefix prefix = DEFAULT_PREFIX);
+		static BasicSizeArray FromUnits(int magnitude, const double* sizes, std::size_t size, BytePrefix prefix = DEFAULT_PREFIX);
+
+		size_type operator[](std::size_t index) const;
+		// Adds or subtracts element by element. Both arrays must have the same number of elements.
+		BasicSizeArray& operator+=(const BasicSizeArray& rhs);
+		BasicSizeArray& operator-=(const BasicSizeArray& rhs);
+		// Adds or subtracts a size from every element.
+		BasicSizeArray& operator+=(const size_type& rhs);
+		BasicSizeArray& operator-=(const size_type& rhs);
+
+	private:
+		size_type FromCount(BitCount bits) const;
+		internal::BitCountTotals Reduce(std::size_t threadCount) const;
+
+		std::vector<BitCount> _bits;
+
+	};
+
+	using ByteSizeArray = BasicSizeArray<ByteTraits>;
+	using BitSizeArray = BasicSizeArray<BitTraits>;
+
+#if !defined(BYTESIZE_HEADER_ONLY)
+	extern template class BasicSizeArray<ByteTraits>;
+	extern template class BasicSizeArray<BitTraits>;
+#endif
+
+}
+
+#include "SizeArray.inl"
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "SizeArray.cc"
+#endif
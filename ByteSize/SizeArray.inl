@@ -0,0 +1,244 @@
+#pragma once
+#include <stdexcept>
+
+namespace hvn3 {
+
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>::BasicSizeArray(BytePrefix prefix) :
+		PrefixPolicy(prefix, prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric) {
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>::BasicSizeArray(std::size_t size, BytePrefix prefix) :
+		PrefixPolicy(prefix, prefix == BytePrefix::Binary ? ByteUnit::IEC : ByteUnit::Metric),
+		_bits(size, 0) {
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BytePrefix BasicSizeArray<Traits, PrefixPolicy>::Prefix() const {
+
+		return PrefixPolicy::Prefix();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline ByteUnit BasicSizeArray<Traits, PrefixPolicy>::Unit() const {
+
+		return PrefixPolicy::Unit();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline std::size_t BasicSizeArray<Traits, PrefixPolicy>::Size() const {
+
+		return _bits.size();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline bool BasicSizeArray<Traits, PrefixPolicy>::Empty() const {
+
+		return _bits.empty();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicSizeArray<Traits, PrefixPolicy>::Reserve(std::size_t capacity) {
+
+		_bits.reserve(capacity);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicSizeArray<Traits, PrefixPolicy>::Resize(std::size_t size) {
+
+		_bits.resize(size, 0);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicSizeArray<Traits, PrefixPolicy>::Clear() {
+
+		_bits.clear();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicSizeArray<Traits, PrefixPolicy>::PushBack(const size_type& size) {
+
+		_bits.push_back(size.ExactBits());
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::Get(std::size_t index) const {
+
+		return FromCount(_bits[index]);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline void BasicSizeArray<Traits, PrefixPolicy>::Set(std::size_t index, const size_type& size) {
+
+		_bits[index] = size.ExactBits();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline BitCount* BasicSizeArray<Traits, PrefixPolicy>::Data() {
+
+		return _bits.data();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline const BitCount* BasicSizeArray<Traits, PrefixPolicy>::Data() const {
+
+		return _bits.data();
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	void BasicSizeArray<Traits, PrefixPolicy>::Bits(double* out) const {
+
+		for (std::size_t i = 0; i < _bits.size(); ++i)
+			out[i] = static_cast<double>(_bits[i]);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	void BasicSizeArray<Traits, PrefixPolicy>::Bytes(double* out) const {
+
+		for (std::size_t i = 0; i < _bits.size(); ++i)
+			out[i] = static_cast<double>(_bits[i]) / size_type::BitsInByte();
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	void BasicSizeArray<Traits, PrefixPolicy>::Units(int magnitude, double* out) const {
+
+		// Divide the same way as BasicSize::Units, so that the results are identical.
+		double bytes_in_unit = size_type::BytesInUnit(magnitude, Prefix());
+
+		for (std::size_t i = 0; i < _bits.size(); ++i)
+			out[i] = static_cast<double>(_bits[i]) / size_type::BitsInByte() / bytes_in_unit;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	std::vector<double> BasicSizeArray<Traits, PrefixPolicy>::Units(int magnitude) const {
+
+		std::vector<double> units(_bits.size());
+
+		Units(magnitude, units.data());
+
+		return units;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::Sum(std::size_t threadCount) const {
+
+		return FromCount(Reduce(threadCount).sum);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::Mean(std::size_t threadCount) const {
+
+		return size_type::FromBits(Reduce(threadCount).mean, Prefix());
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::Min(std::size_t threadCount) const {
+
+		return FromCount(Reduce(threadCount).min);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::Max(std::size_t threadCount) const {
+
+		return FromCount(Reduce(threadCount).max);
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy> BasicSizeArray<Traits, PrefixPolicy>::FromBytes(const double* sizes, std::size_t size, BytePrefix prefix) {
+
+		BasicSizeArray array(size, prefix);
+
+		BytesToBits(sizes, size, array._bits.data());
+
+		return array;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy> BasicSizeArray<Traits, PrefixPolicy>::FromUnits(int magnitude, const double* sizes, std::size_t size, BytePrefix prefix) {
+
+		BasicSizeArray array(size, prefix);
+		std::vector<double> bytes(sizes, sizes + size);
+		double bytes_in_unit = size_type::BytesInUnit(magnitude, array.Prefix());
+
+		for (double& value : bytes)
+			value *= bytes_in_unit;
+
+		BytesToBits(bytes.data(), size, array._bits.data());
+
+		return array;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::operator[](std::size_t index) const {
+
+		return Get(index);
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>& BasicSizeArray<Traits, PrefixPolicy>::operator+=(const BasicSizeArray& rhs) {
+
+		if (rhs._bits.size() != _bits.size())
+			throw std::invalid_argument("The arrays must have the same number of elements.");
+
+		for (std::size_t i = 0; i < _bits.size(); ++i)
+			_bits[i] = SaturatingAdd(_bits[i], rhs._bits[i]);
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>& BasicSizeArray<Traits, PrefixPolicy>::operator-=(const BasicSizeArray& rhs) {
+
+		if (rhs._bits.size() != _bits.size())
+			throw std::invalid_argument("The arrays must have the same number of elements.");
+
+		for (std::size_t i = 0; i < _bits.size(); ++i)
+			_bits[i] = SaturatingSubtract(_bits[i], rhs._bits[i]);
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>& BasicSizeArray<Traits, PrefixPolicy>::operator+=(const size_type& rhs) {
+
+		BitCount bits = rhs.ExactBits();
+
+		for (BitCount& element : _bits)
+			element = SaturatingAdd(element, bits);
+
+		return *this;
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	BasicSizeArray<Traits, PrefixPolicy>& BasicSizeArray<Traits, PrefixPolicy>::operator-=(const size_type& rhs) {
+
+		BitCount bits = rhs.ExactBits();
+
+		for (BitCount& element : _bits)
+			element = SaturatingSubtract(element, bits);
+
+		return *this;
+
+	}
+
+	template <typename Traits, typename PrefixPolicy>
+	inline typename BasicSizeArray<Traits, PrefixPolicy>::size_type BasicSizeArray<Traits, PrefixPolicy>::FromCount(BitCount bits) const {
+
+		return size_type::FromExactBits(bits, Prefix());
+
+	}
+	template <typename Traits, typename PrefixPolicy>
+	inline internal::BitCountTotals BasicSizeArray<Traits, PrefixPolicy>::Reduce(std::size_t threadCount) const {
+
+		return internal::ReduceBitCounts(_bits.data(), _bits.size(), threadCount);
+
+	}
+
+}
@@ -0,0 +1,145 @@
+#include "SizeClassMap.h"
+#include <stdexcept>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE SizeClassMap::SizeClassMap(const std::vector<ByteSize>& classes) :
+		_sub_bucket_bits(0),
+		_prefix(classes.empty() ? ByteSize::DEFAULT_PREFIX : classes.front().Prefix()) {
+
+		if (classes.empty())
+			throw std::invalid_argument("At least one size class is required.");
+
+		for (const ByteSize& size : classes) {
+
+			std::uint64_t bytes = ToBytes(size);
+
+			if (bytes == 0 || (!_class_bytes.empty() && bytes <= _class_bytes.back()))
+				throw std::invalid_argument("Size classes must be positive and in increasing order.");
+
+			_class_bytes.push_back(bytes);
+
+		}
+
+		// Use the fewest bits that put each class boundary in a bucket of its own.
+		for (bool separated = false; !separated && _sub_bucket_bits < MAX_SUB_BUCKET_BITS; ) {
+
+			separated = true;
+
+			for (std::size_t i = 1; i < _class_bytes.size() && separated; ++i)
+				separated = BucketIndex(_class_bytes[i - 1], _sub_bucket_bits) != BucketIndex(_class_bytes[i], _sub_bucket_bits);
+
+			if (!separated)
+				++_sub_bucket_bits;
+
+		}
+
+		// Each bucket stores the class of the smallest size it holds, which is the first class in the same bucket or after it. Sizes past the
+		// largest class are rejected before the table is read, so it ends at the largest class's bucket.
+		_bucket_classes.resize(BucketIndex(_class_bytes.back(), _sub_bucket_bits) + 1);
+
+		for (std::size_t bucket = 0, index = 0; bucket < _bucket_classes.size(); ++bucket) {
+
+			while (BucketIndex(_class_bytes[index], _sub_bucket_bits) < bucket)
+				++index;
+
+			_bucket_classes[bucket] = static_cast<std::uint32_t>(index);
+
+		}
+
+	}
+
+	BYTESIZE_INLINE std::size_t SizeClassMap::ClassCount() const {
+
+		return _class_bytes.size();
+
+	}
+
+	BYTESIZE_INLINE std::size_t SizeClassMap::ClassIndex(std::uint64_t bytes) const {
+
+		if (bytes > _class_bytes.back())
+			return _class_bytes.size();
+
+		std::size_t index = _bucket_classes[BucketIndex(bytes, _sub_bucket_bits)];
+
+		// Only runs more than once if two classes were too close together to be given buckets of their own.
+		while (bytes > _class_bytes[index])
+			++index;
+
+		return index;
+
+	}
+	BYTESIZE_INLINE std::size_t SizeClassMap::ClassIndex(const ByteSize& size) const {
+
+		return ClassIndex(ToBytes(size));
+
+	}
+	BYTESIZE_INLINE ByteSize SizeClassMap::ClassSize(std::size_t index) const {
+
+		return ByteSize(_class_bytes[index], _prefix);
+
+	}
+
+	BYTESIZE_INLINE ByteSize SizeClassMap::RoundUp(const ByteSize& size) const {
+
+		std::size_t index = ClassIndex(size);
+
+		return index < _class_bytes.size() ? ClassSize(index) : size;
+
+	}
+	BYTESIZE_INLINE double SizeClassMap::Fragmentation(const ByteSize& size) const {
+
+		std::uint64_t bytes = ToBytes(size);
+		std::size_t index = ClassIndex(bytes);
+
+		if (index >= _class_bytes.size())
+			return 0.0;
+
+		return static_cast<double>(_class_bytes[index] - bytes) / static_cast<double>(_class_bytes[index]);
+
+	}
+
+	BYTESIZE_INLINE std::string SizeClassMap::ToString(unsigned int precision) const {
+
+		std::string string;
+
+		for (std::size_t i = 0; i < _class_bytes.size(); ++i) {
+
+			if (i > 0)
+				string += ", ";
+
+			string += ClassSize(i).ToString(precision);
+
+		}
+
+		return string;
+
+	}
+
+	BYTESIZE_INLINE std::size_t SizeClassMap::BucketIndex(std::uint64_t bytes, int subBucketBits) {
+
+		std::uint64_t sub_bucket_count = std::uint64_t(1) << subBucketBits;
+
+		if (bytes < sub_bucket_count)
+			return static_cast<std::size_t>(bytes);
+
+		int shift = HighestSetBit(bytes) - subBucketBits;
+
+		return static_cast<std::size_t>(sub_bucket_count + static_cast<std::uint64_t>(shift) * sub_bucket_count + ((bytes >> shift) - sub_bucket_count));
+
+	}
+	BYTESIZE_INLINE std::uint64_t SizeClassMap::ToBytes(const ByteSize& size) {
+
+		BitCount bits = size.ExactBits();
+
+		if (bits <= 0)
+			return 0;
+
+		// A partial byte still needs a whole byte to hold it.
+		BitCount bytes = bits / 8 + (bits % 8 != 0);
+
+		return static_cast<UnsignedBitCount>(bytes) > UINT64_MAX ? UINT64_MAX : static_cast<std::uint64_t>(bytes);
+
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "ByteSize.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hvn3 {
+
+	// Maps sizes to the smallest of a list of size classes (e.g. 8 KiB, 64 KiB, 1 MiB) that can hold them, in constant time.
+	// Sizes are bucketed the way ByteSizeHistogram does it, by their highest set bit and the bits after it, with just enough bits that no bucket
+	// contains more than one class boundary. Each bucket then stores the class of its smallest size, and a lookup is a table read followed by
+	// at most one comparison.
+	class SizeClassMap {
+
+	public:
+		// Classes must be positive and in increasing order, or std::invalid_argument is thrown. Partial bytes are rounded up.
+		explicit SizeClassMap(const std::vector<ByteSize>& classes);
+
+		std::size_t ClassCount() const;
+
+		// Returns the index of the smallest class that can hold the size, or ClassCount() if it is larger than every class.
+		std::size_t ClassIndex(std::uint64_t bytes) const;
+		std::size_t ClassIndex(const ByteSize& size) const;
+		ByteSize ClassSize(std::size_t index) const;
+
+		// Returns the size of the class that holds the size, or the size itself if it is larger than every class.
+		ByteSize RoundUp(const ByteSize& size) const;
+		// Returns the fraction of the class that is left unused by the size (internal fragmentation), from 0 up to 1.
+		double Fragmentation(const ByteSize& size) const;
+
+		// Returns the classes as a list such as "8.00 KiB, 64.00 KiB, 1.00 MiB".
+		std::string ToString(unsigned int precision = 2) const;
+
+	private:
+		// Largest number of bits after the highest set bit used to bucket sizes. Classes closer together than this allows are told apart by
+		// extra comparisons.
+		static constexpr int MAX_SUB_BUCKET_BITS = 12;
+
+		static std::size_t BucketIndex(std::uint64_t bytes, int subBucketBits);
+		static std::uint64_t ToBytes(const ByteSize& size);
+
+		std::vector<std::uint64_t> _class_bytes;
+		std::vector<std::uint32_t> _bucket_classes;
+		int _sub_bucket_bits;
+		BytePrefix _prefix;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "SizeClassMap.cc"
+#endif
@@ -0,0 +1,84 @@
+#include "SizeFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE std::to_chars_result SizeFormat::Write(char* first, char* last, double value, const char* symbol) const {
+
+		unsigned int precision = _precision;
+
+		if (_significant) {
+
+			// The number of digits before the decimal point, which is zero or less for values below one (e.g. -1 for 0.0123).
+			double magnitude = std::fabs(value);
+			int significant = (std::max)(static_cast<int>(_precision), 1);
+			int integer_digits = magnitude == 0.0 ? 1 : static_cast<int>(std::floor(std::log10(magnitude))) + 1;
+			int digits = significant - integer_digits;
+
+			// Rounding can carry into another digit before the decimal point (9.96 is 10.0 to three significant digits).
+			if (digits > 0 && std::round(magnitude * std::pow(10.0, digits)) >= std::pow(10.0, significant))
+				--digits;
+
+			// Digits before the decimal point past the precision are rounded to zeros (1023.5 is 1020 to three significant digits).
+			if (digits < 0) {
+
+				double scale = std::pow(10.0, -digits);
+
+				value = std::round(value / scale) * scale;
+
+			}
+
+			precision = static_cast<unsigned int>((std::min)((std::max)(digits, 0), static_cast<int>(MAX_PRECISION)));
+
+		}
+
+		char number[160];
+		std::to_chars_result result = FormatSize(number, number + sizeof(number), value, symbol, precision);
+
+		if (result.ec != std::errc())
+			return { last, std::errc::value_too_large };
+
+		// FormatSize wrote the number, a space and the symbol.
+		std::size_t symbol_length = std::strlen(symbol);
+		const char* number_last = result.ptr - symbol_length - 1;
+		const char* integer_first = number[0] == '-' ? number + 1 : number;
+		const char* integer_last = std::find(integer_first, number_last, '.');
+
+		char output[256];
+		char* it = std::copy(static_cast<const char*>(number), integer_first, output);
+
+		for (const char* digit = integer_first; digit != integer_last; ++digit) {
+
+			if (_grouping && digit != integer_first && (integer_last - digit) % 3 == 0)
+				*it++ = ',';
+
+			*it++ = *digit;
+
+		}
+
+		it = std::copy(integer_last, number_last, it);
+
+		if (_space)
+			*it++ = ' ';
+
+		it = std::copy(symbol, symbol + symbol_length, it);
+
+		std::size_t length = static_cast<std::size_t>(it - output);
+		std::size_t padding = _width > length ? _width - length : 0;
+
+		if (static_cast<std::size_t>(last - first) < length + padding)
+			return { last, std::errc::value_too_large };
+
+		std::size_t left_padding = _align == '<' ? 0 : _align == '^' ? padding / 2 : padding;
+
+		first = std::fill_n(first, left_padding, _fill);
+		first = std::copy(output, it, first);
+		first = std::fill_n(first, padding - left_padding, _fill);
+
+		return { first, std::errc() };
+
+	}
+
+}
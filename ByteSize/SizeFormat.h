@@ -0,0 +1,333 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+#if defined(BYTESIZE_FMT)
+#include <fmt/format.h>
+#endif
+
+namespace hvn3 {
+
+	// How to format sizes, parsed once from a spec and then used to format any number of ByteSize and BitSize values.
+	// The spec is like a std::format spec: [[fill]align]['#'][width][','][.precision['s']][iec|jedec|metric]['@'unit]
+	//   fill, align  Pads the result to width with fill (a space by default), aligned left ('<'), right ('>', the default) or centered ('^').
+	//   '#'          Leaves out the space between the value and the unit ("1.50KiB").
+	//   ','          Separates thousands in the value with commas.
+	//   precision    The number of digits after the decimal point (2 by default), or significant digits if followed by 's'. Significant
+	//                digits round the value as a whole, so digits before the decimal point can become zeros (1023.5 KiB is "1020 KiB" with ".3s").
+	//   iec, jedec, metric  The unit system: binary units with IEC symbols (KiB), binary units with JEDEC symbols (KB), or decimal units (kB).
+	//                By default, each value's own unit system is used.
+	//   unit         Always uses this unit (e.g. "@MiB" or "@GB") instead of the largest one in which the value is at least one. The unit sets
+	//                the magnitude and unit system, and applies to bit sizes too, so "@MiB" formats a BitSize in Mibit.
+	// For example, "{:>12,.1iec}" right-aligns sizes such as "1,023.5 KiB" in 12 characters.
+	class SizeFormat {
+
+	public:
+		constexpr SizeFormat() noexcept = default;
+		// Throws std::invalid_argument if the spec is not valid.
+		constexpr explicit SizeFormat(std::string_view spec) {
+
+			ParseResult result = TryParse(spec, *this);
+
+			if (!result)
+				throw std::invalid_argument("Invalid size format spec.");
+
+		}
+
+		// Formats the size into [first, last). Nothing is allocated. If the buffer is too small, ec is set to std::errc::value_too_large.
+		template <typename Traits, typename PrefixPolicy>
+		std::to_chars_result Format(const BasicSize<Traits, PrefixPolicy>& size, char* first, char* last) const {
+
+			BytePrefix prefix = _has_system ? _prefix : size.Prefix();
+			ByteUnit unit = _has_system ? _unit : size.Unit();
+
+			if (_magnitude >= 0) {
+
+				double value = static_cast<double>(size.ExactBits()) / (UNIT_MULTIPLIERS[static_cast<int>(prefix)][_magnitude] * Traits::BITS_IN_UNIT);
+
+				return Write(first, last, value, Traits::SYMBOLS[static_cast<int>(unit)][_magnitude]);
+
+			}
+
+			UnitSelection selection = SelectUnit<Traits::BITS_IN_UNIT>(size.ExactBits(), prefix);
+
+			return Write(first, last, selection.value, selection.magnitude < 0 ? BIT_SYMBOL : Traits::SYMBOLS[static_cast<int>(unit)][selection.magnitude]);
+
+		}
+		template <typename Traits, typename PrefixPolicy>
+		std::string ToString(const BasicSize<Traits, PrefixPolicy>& size) const {
+
+			char buffer[MAX_LENGTH];
+			std::to_chars_result result = Format(size, buffer, buffer + sizeof(buffer));
+
+			return std::string(buffer, result.ptr);
+
+		}
+
+		static constexpr ParseResult TryParse(std::string_view spec, SizeFormat& format);
+
+	private:
+		// Limits that keep every formatted size within MAX_LENGTH characters.
+		static constexpr unsigned int MAX_WIDTH = 256;
+		static constexpr unsigned int MAX_PRECISION = 64;
+		static constexpr std::size_t MAX_LENGTH = 512;
+
+		static constexpr bool IsAlign(char c) {
+			return c == '<' || c == '>' || c == '^';
+		}
+		static constexpr bool ReadNumber(std::string_view spec, std::size_t& position, unsigned int max, unsigned int& value);
+		template <typename Traits>
+		static constexpr bool FindSymbol(std::string_view symbol, bool hasSystem, ByteUnit& unit, int& magnitude);
+
+		std::to_chars_result Write(char* first, char* last, double value, const char* symbol) const;
+
+		char _fill = ' ';
+		char _align = '>';
+		unsigned int _width = 0;
+		bool _space = true;
+		bool _grouping = false;
+		unsigned int _precision = 2;
+		bool _significant = false;
+		bool _has_system = false;
+		BytePrefix _prefix = BytePrefix::Binary;
+		ByteUnit _unit = ByteUnit::IEC;
+		// The magnitude of the unit to always use, or -1 to choose one for each value.
+		int _magnitude = -1;
+
+	};
+
+	constexpr ParseResult SizeFormat::TryParse(std::string_view spec, SizeFormat& format) {
+
+		SizeFormat result;
+		std::size_t position = 0;
+
+		if (spec.size() >= 2 && IsAlign(spec[1]) && spec[0] != '{' && spec[0] != '}') {
+
+			result._fill = spec[0];
+			result._align = spec[1];
+			position = 2;
+
+		}
+		else if (!spec.empty() && IsAlign(spec[0])) {
+
+			result._align = spec[0];
+			position = 1;
+
+		}
+
+		if (position < spec.size() && spec[position] == '#') {
+
+			result._space = false;
+			++position;
+
+		}
+
+		if (!ReadNumber(spec, position, MAX_WIDTH, result._width))
+			return { ParseError::NumberOutOfRange, position };
+
+		if (position < spec.size() && spec[position] == ',') {
+
+			result._grouping = true;
+			++position;
+
+		}
+
+		if (position < spec.size() && spec[position] == '.') {
+
+			++position;
+
+			if (position == spec.size() || !internal::IsDigit(spec[position]))
+				return { ParseError::InvalidNumber, position };
+
+			if (!ReadNumber(spec, position, MAX_PRECISION, result._precision))
+				return { ParseError::NumberOutOfRange, position };
+
+			if (position < spec.size() && spec[position] == 's') {
+
+				result._significant = true;
+				++position;
+
+			}
+
+		}
+
+		constexpr std::string_view SYSTEM_NAMES[] = { "metric", "iec", "jedec" };
+
+		for (std::size_t i = 0; i < 3; ++i) {
+
+			if (spec.substr(position, SYSTEM_NAMES[i].size()) == SYSTEM_NAMES[i]) {
+
+				result._has_system = true;
+				result._unit = static_cast<ByteUnit>(i);
+				result._prefix = result._unit == ByteUnit::Metric ? BytePrefix::Decimal : BytePrefix::Binary;
+				position += SYSTEM_NAMES[i].size();
+
+				break;
+
+			}
+
+		}
+
+		if (position < spec.size() && spec[position] == '@') {
+
+			std::string_view symbol = spec.substr(position + 1);
+			ByteUnit unit = result._unit;
+
+			if (!FindSymbol<ByteTraits>(symbol, result._has_system, unit, result._magnitude) && !FindSymbol<BitTraits>(symbol, result._has_system, unit, result._magnitude))
+				return { ParseError::InvalidSuffix, position + 1 };
+
+			// The base unit is the same in every unit system, so it doesn't choose one.
+			if (result._magnitude > 0 && !result._has_system) {
+
+				result._has_system = true;
+				result._unit = unit;
+				result._prefix = unit == ByteUnit::Metric ? BytePrefix::Decimal : BytePrefix::Binary;
+
+			}
+
+			position = spec.size();
+
+		}
+
+		if (position != spec.size())
+			return { ParseError::TrailingCharacters, position };
+
+		format = result;
+
+		return { ParseError::None, position };
+
+	}
+	constexpr bool SizeFormat::ReadNumber(std::string_view spec, std::size_t& position, unsigned int max, unsigned int& value) {
+
+		unsigned int number = 0;
+		bool found = false;
+
+		for (; position < spec.size() && internal::IsDigit(spec[position]); ++position) {
+
+			number = number * 10 + static_cast<unsigned int>(spec[position] - '0');
+			found = true;
+
+			if (number > max)
+				return false;
+
+		}
+
+		if (found)
+			value = number;
+
+		return true;
+
+	}
+	template <typename Traits>
+	constexpr bool SizeFormat::FindSymbol(std::string_view symbol, bool hasSystem, ByteUnit& unit, int& magnitude) {
+
+		// Symbols shared by two unit systems ("MB") are taken to be metric unless the spec chose JEDEC.
+		for (int system = 0; system < 3; ++system) {
+
+			if (hasSystem && system != static_cast<int>(unit))
+				continue;
+
+			for (int i = 0; i <= MAX_MAGNITUDE; ++i) {
+
+				if (symbol == Traits::SYMBOLS[system][i]) {
+
+					unit = static_cast<ByteUnit>(system);
+					magnitude = i;
+
+					return true;
+
+				}
+
+			}
+
+		}
+
+		return false;
+
+	}
+
+}
+
+#if defined(__cpp_lib_format)
+
+// Formats sizes with std::format, e.g. std::format("{:.1iec}", size). The spec is parsed by SizeFormat at compile time.
+template <typename Traits, typename PrefixPolicy>
+struct std::formatter<hvn3::BasicSize<Traits, PrefixPolicy>, char> {
+
+	hvn3::SizeFormat size_format;
+
+	constexpr std::format_parse_context::iterator parse(std::format_parse_context& context) {
+
+		std::format_parse_context::iterator it = context.begin();
+
+		while (it != context.end() && *it != '}')
+			++it;
+
+		if (!hvn3::SizeFormat::TryParse(std::string_view(context.begin(), it), size_format))
+			throw std::format_error("Invalid size format spec.");
+
+		return it;
+
+	}
+	template <typename FormatContext>
+	typename FormatContext::iterator format(const hvn3::BasicSize<Traits, PrefixPolicy>& size, FormatContext& context) const {
+
+		char buffer[512];
+		std::to_chars_result result = size_format.Format(size, buffer, buffer + sizeof(buffer));
+
+		return std::copy(buffer, result.ptr, context.out());
+
+	}
+
+};
+
+#endif
+
+#if defined(BYTESIZE_FMT)
+
+// Formats sizes with fmt, e.g. fmt::format("{:.1iec}", size).
+template <typename Traits, typename PrefixPolicy>
+struct fmt::formatter<hvn3::BasicSize<Traits, PrefixPolicy>, char> {
+
+	hvn3::SizeFormat size_format;
+
+	constexpr fmt::format_parse_context::iterator parse(fmt::format_parse_context& context) {
+
+		fmt::format_parse_context::iterator it = context.begin();
+
+		while (it != context.end() && *it != '}')
+			++it;
+
+		if (!hvn3::SizeFormat::TryParse(std::string_view(context.begin(), static_cast<std::size_t>(it - context.begin())), size_format))
+			throw fmt::format_error("Invalid size format spec.");
+
+		return it;
+
+	}
+	template <typename FormatContext>
+	auto format(const hvn3::BasicSize<Traits, PrefixPolicy>& size, FormatContext& context) const -> decltype(context.out()) {
+
+		char buffer[512];
+		std::to_chars_result result = size_format.Format(size, buffer, buffer + sizeof(buffer));
+
+		return std::copy(buffer, result.ptr, context.out());
+
+	}
+
+};
+
+#endif
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "SizeFormat.cc"
+#endif
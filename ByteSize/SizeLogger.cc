@@ -0,0 +1,178 @@
+#include "SizeLogger.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE SizeLogger::SizeLogger(Sink sink, std::size_t capacity, std::chrono::microseconds pollInterval) :
+		_sink(std::move(sink)),
+		_mask(1),
+		_poll_interval(pollInterval),
+		_write_position(0),
+		_read_position(0),
+		_dropped(0),
+		_stopping(false) {
+
+		while (_mask < capacity)
+			_mask *= 2;
+
+		_records.reset(new Record[_mask]);
+
+		for (std::size_t i = 0; i < _mask; ++i)
+			_records[i].sequence.store(i, std::memory_order_relaxed);
+
+		_mask -= 1;
+
+		_thread = std::thread(&SizeLogger::Run, this);
+
+	}
+	BYTESIZE_INLINE SizeLogger::~SizeLogger() {
+
+		_stopping.store(true, std::memory_order_release);
+
+		_thread.join();
+
+	}
+
+	BYTESIZE_INLINE bool SizeLogger::Log(const char* message, const ByteSize& size, unsigned int precision) noexcept {
+
+		return Push(message, size, precision, false);
+
+	}
+	BYTESIZE_INLINE bool SizeLogger::Log(const char* message, const BitSize& size, unsigned int precision) noexcept {
+
+		return Push(message, ByteSize(size), precision, true);
+
+	}
+
+	BYTESIZE_INLINE void SizeLogger::Flush() const {
+
+		std::size_t position = _write_position.load(std::memory_order_acquire);
+
+		while (_read_position.load(std::memory_order_acquire) < position)
+			std::this_thread::sleep_for(_poll_interval);
+
+	}
+
+	BYTESIZE_INLINE std::uint64_t SizeLogger::Dropped() const {
+
+		return _dropped.load(std::memory_order_relaxed);
+
+	}
+
+	BYTESIZE_INLINE bool SizeLogger::Push(const char* message, const ByteSize& size, unsigned int precision, bool bits) noexcept {
+
+		// A bounded multi-producer queue: each writer claims a position, and may write the slot for it once the reader has released it.
+		std::size_t position = _write_position.load(std::memory_order_relaxed);
+		Record* record;
+
+		for (;;) {
+
+			record = &_records[position & _mask];
+
+			std::size_t sequence = record->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+			if (difference == 0) {
+
+				if (_write_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+
+			}
+			else if (difference < 0) {
+
+				_dropped.fetch_add(1, std::memory_order_relaxed);
+
+				return false;
+
+			}
+			else {
+
+				position = _write_position.load(std::memory_order_relaxed);
+
+			}
+
+		}
+
+		record->message = message;
+		record->size = size;
+		record->precision = static_cast<std::uint8_t>(std::min(precision, MAX_PRECISION));
+		record->bits = bits;
+
+		record->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+
+	}
+	BYTESIZE_INLINE std::size_t SizeLogger::Drain() {
+
+		std::size_t position = _read_position.load(std::memory_order_relaxed);
+		std::size_t count = 0;
+
+		for (;;) {
+
+			Record& record = _records[position & _mask];
+
+			if (record.sequence.load(std::memory_order_acquire) != position + 1)
+				break;
+
+			Write(record);
+
+			// Release the slot to the writer that will wrap around to it.
+			record.sequence.store(position + _mask + 1, std::memory_order_release);
+
+			++position;
+			++count;
+
+			_read_position.store(position, std::memory_order_release);
+
+		}
+
+		return count;
+
+	}
+	BYTESIZE_INLINE void SizeLogger::Write(const Record& record) {
+
+		char line[MAX_LINE_LENGTH];
+		std::size_t message_length = std::min(std::strlen(record.message), MAX_LINE_LENGTH / 2);
+
+		std::memcpy(line, record.message, message_length);
+
+		line[message_length] = ' ';
+
+		char* first = line + message_length + 1;
+		char* last = line + sizeof(line);
+		std::to_chars_result result = record.bits ? BitSize(record.size).ToChars(first, last, record.precision) : record.size.ToChars(first, last, record.precision);
+
+		// Half of the line is left for the size, which is enough at MAX_PRECISION. Should it not be, the default precision always fits.
+		if (result.ec != std::errc())
+			result = record.bits ? BitSize(record.size).ToChars(first, last) : record.size.ToChars(first, last);
+
+		if (result.ec != std::errc())
+			result.ptr = first - 1;
+
+		_sink(std::string_view(line, static_cast<std::size_t>(result.ptr - line)));
+
+	}
+	BYTESIZE_INLINE void SizeLogger::Run() {
+
+		for (;;) {
+
+			// Anything logged before the logger started stopping is written before the thread exits.
+			bool stopping = _stopping.load(std::memory_order_acquire);
+
+			if (Drain() == 0) {
+
+				if (stopping)
+					break;
+
+				std::this_thread::sleep_for(_poll_interval);
+
+			}
+
+		}
+
+	}
+
+}
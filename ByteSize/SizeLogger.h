@@ -0,0 +1,85 @@
+#pragma once
+#include "ByteSize.h"
+#include "BitSize.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace hvn3 {
+
+	// Logs sizes without formatting them on the logging thread.
+	// Log stores the message pointer and the size's bit count, prefix, unit and precision in a fixed-size record in a lock-free ring buffer,
+	// which any number of threads can write to. A background thread formats the records with ToChars and passes each line (e.g.
+	// "read 1.50 MiB") to the sink. If the ring buffer is full, the record is dropped rather than making the logging thread wait.
+	class SizeLogger {
+
+	public:
+		// Receives each formatted line, on the background thread. The line is only valid during the call.
+		typedef std::function<void(std::string_view line)> Sink;
+
+		// capacity is the number of records the ring buffer holds, rounded up to a power of two. When the buffer is empty, the background
+		// thread checks it again after pollInterval.
+		explicit SizeLogger(Sink sink, std::size_t capacity = 8192, std::chrono::microseconds pollInterval = std::chrono::milliseconds(1));
+		SizeLogger(const SizeLogger&) = delete;
+		// Writes the records still in the buffer before returning.
+		~SizeLogger();
+
+		// The largest precision sizes are written with. Larger precisions are reduced to it, so that every size fits in a line.
+		static constexpr unsigned int MAX_PRECISION = 64;
+
+		// The message is stored as a pointer, so it must outlive the logger (e.g. a string literal). Returns false if the record was dropped
+		// because the buffer was full.
+		bool Log(const char* message, const ByteSize& size, unsigned int precision = 2) noexcept;
+		bool Log(const char* message, const BitSize& size, unsigned int precision = 2) noexcept;
+
+		// Waits until everything logged before the call has been passed to the sink.
+		void Flush() const;
+
+		// Returns the number of records dropped because the buffer was full.
+		std::uint64_t Dropped() const;
+
+		SizeLogger& operator=(const SizeLogger&) = delete;
+
+	private:
+		// The largest line passed to the sink. Longer messages are truncated.
+		static constexpr std::size_t MAX_LINE_LENGTH = 256;
+
+		struct Record {
+			// Equal to the position of the record that may be written next into this slot, and one more than that once it has been written.
+			std::atomic<std::size_t> sequence;
+			const char* message;
+			// BitSize records are stored as a ByteSize with the same bit count, prefix and unit.
+			ByteSize size{ 0 };
+			std::uint8_t precision;
+			bool bits;
+		};
+
+		bool Push(const char* message, const ByteSize& size, unsigned int precision, bool bits) noexcept;
+		std::size_t Drain();
+		void Write(const Record& record);
+		void Run();
+
+		Sink _sink;
+		std::unique_ptr<Record[]> _records;
+		std::size_t _mask;
+		std::chrono::microseconds _poll_interval;
+
+		alignas(64) std::atomic<std::size_t> _write_position;
+		alignas(64) std::atomic<std::size_t> _read_position;
+		std::atomic<std::uint64_t> _dropped;
+		std::atomic<bool> _stopping;
+
+		std::thread _thread;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "SizeLogger.cc"
+#endif
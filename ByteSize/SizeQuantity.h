@@ -0,0 +1,333 @@
+#pragma once
+#include "ByteSizeCommon.h"
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <type_traits>
+
+namespace hvn3 {
+
+	// A count of units whose size in bytes is given by Period, in the style of std::chrono::duration.
+	// Conversions and arithmetic are constexpr, so sizes such as 64_KiB can be used as compile-time constants.
+	template <typename Rep, typename Period = std::ratio<1>>
+	class SizeQuantity;
+
+	template <typename T>
+	struct IsSizeQuantity :
+		std::false_type {
+	};
+	template <typename Rep, typename Period>
+	struct IsSizeQuantity<SizeQuantity<Rep, Period>> :
+		std::true_type {
+	};
+
+	// Converts a quantity to another unit, truncating toward zero if the destination is integral.
+	template <typename ToQuantity, typename Rep, typename Period, typename std::enable_if<IsSizeQuantity<ToQuantity>::value, int>::type = 0>
+	constexpr ToQuantity QuantityCast(const SizeQuantity<Rep, Period>& quantity) {
+
+		using Ratio = std::ratio_divide<Period, typename ToQuantity::period>;
+		using CommonRep = typename std::common_type<typename ToQuantity::rep, Rep, std::intmax_t>::type;
+		using ToRep = typename ToQuantity::rep;
+
+		if constexpr (Ratio::num == 1 && Ratio::den == 1)
+			return ToQuantity(static_cast<ToRep>(quantity.Count()));
+		else if constexpr (Ratio::den == 1)
+			return ToQuantity(static_cast<ToRep>(static_cast<CommonRep>(quantity.Count()) * static_cast<CommonRep>(Ratio::num)));
+		else if constexpr (Ratio::num == 1)
+			return ToQuantity(static_cast<ToRep>(static_cast<CommonRep>(quantity.Count()) / static_cast<CommonRep>(Ratio::den)));
+		else
+			return ToQuantity(static_cast<ToRep>(static_cast<CommonRep>(quantity.Count()) * static_cast<CommonRep>(Ratio::num) / static_cast<CommonRep>(Ratio::den)));
+
+	}
+
+	template <typename Rep, typename Period>
+	class SizeQuantity {
+
+		static_assert(std::is_arithmetic<Rep>::value, "Rep must be an arithmetic type.");
+
+	public:
+		using rep = Rep;
+		using period = typename Period::type;
+
+		constexpr SizeQuantity() = default;
+		// Integral quantities can only be constructed from integral counts, since the fraction would otherwise be lost.
+		template <typename Rep2, typename std::enable_if<std::is_convertible<const Rep2&, Rep>::value &&
+			(std::is_floating_point<Rep>::value || !std::is_floating_point<Rep2>::value), int>::type = 0>
+		constexpr explicit SizeQuantity(const Rep2& count) :
+			_count(static_cast<Rep>(count)) {
+		}
+		// Only lossless conversions are implicit; use QuantityCast for the others.
+		template <typename Rep2, typename Period2, typename std::enable_if<std::is_floating_point<Rep>::value ||
+			(std::ratio_divide<Period2, period>::den == 1 && !std::is_floating_point<Rep2>::value), int>::type = 0>
+		constexpr SizeQuantity(const SizeQuantity<Rep2, Period2>& other) :
+			_count(QuantityCast<SizeQuantity>(other).Count()) {
+		}
+
+		constexpr Rep Count() const {
+			return _count;
+		}
+
+		constexpr SizeQuantity operator+() const {
+			return *this;
+		}
+		constexpr SizeQuantity operator-() const {
+			return SizeQuantity(-_count);
+		}
+
+		constexpr SizeQuantity& operator+=(const SizeQuantity& rhs) {
+			_count += rhs._count;
+			return *this;
+		}
+		constexpr SizeQuantity& operator-=(const SizeQuantity& rhs) {
+			_count -= rhs._count;
+			return *this;
+		}
+		constexpr SizeQuantity& operator*=(const Rep& rhs) {
+			_count *= rhs;
+			return *this;
+		}
+		constexpr SizeQuantity& operator/=(const Rep& rhs) {
+			_count /= rhs;
+			return *this;
+		}
+
+		static constexpr SizeQuantity Zero() {
+			return SizeQuantity(Rep(0));
+		}
+		static constexpr SizeQuantity MinValue() {
+			return SizeQuantity(std::numeric_limits<Rep>::lowest());
+		}
+		static constexpr SizeQuantity MaxValue() {
+			return SizeQuantity((std::numeric_limits<Rep>::max)());
+		}
+
+	private:
+		Rep _count = Rep(0);
+
+	};
+
+	// Returns the exact number of bits in a quantity, saturating like the rest of the library.
+	// Fractional bits in floating-point quantities are rounded away from zero, as in BytesToBits.
+	template <typename Rep, typename Period>
+	constexpr BitCount QuantityToBits(const SizeQuantity<Rep, Period>& quantity) {
+
+		using BitRatio = std::ratio_multiply<Period, std::ratio<8>>;
+
+		if constexpr (std::is_floating_point<Rep>::value)
+			return BytesToBits(static_cast<double>(quantity.Count()) * static_cast<double>(Period::num) / static_cast<double>(Period::den));
+		else if constexpr (BitRatio::den == 1)
+			return SaturatingMultiply(static_cast<BitCount>(quantity.Count()), static_cast<BitCount>(BitRatio::num));
+		else
+			return SaturatingMultiply(static_cast<BitCount>(quantity.Count()), static_cast<BitCount>(BitRatio::num)) / static_cast<BitCount>(BitRatio::den);
+
+	}
+
+	// Returns the prefix a unit belongs to: binary for powers of two like kibibytes, decimal for units like megabits.
+	// Bits and bytes belong to neither, so the fallback is returned for them.
+	template <typename Period>
+	constexpr BytePrefix QuantityPrefix(BytePrefix fallback) {
+
+		constexpr std::intmax_t bytes = Period::num / Period::den;
+
+		if constexpr (bytes < 125)
+			return fallback;
+		else if constexpr ((bytes & (bytes - 1)) == 0)
+			return BytePrefix::Binary;
+		else
+			return BytePrefix::Decimal;
+
+	}
+
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type operator+(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		using Common = typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type;
+
+		return Common(Common(lhs).Count() + Common(rhs).Count());
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type operator-(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		using Common = typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type;
+
+		return Common(Common(lhs).Count() - Common(rhs).Count());
+
+	}
+	template <typename Rep1, typename Period, typename Rep2, typename std::enable_if<!IsSizeQuantity<Rep2>::value, int>::type = 0>
+	constexpr SizeQuantity<typename std::common_type<Rep1, Rep2>::type, Period> operator*(const SizeQuantity<Rep1, Period>& lhs, const Rep2& rhs) {
+
+		return SizeQuantity<typename std::common_type<Rep1, Rep2>::type, Period>(lhs.Count() * rhs);
+
+	}
+	template <typename Rep1, typename Rep2, typename Period, typename std::enable_if<!IsSizeQuantity<Rep1>::value, int>::type = 0>
+	constexpr SizeQuantity<typename std::common_type<Rep1, Rep2>::type, Period> operator*(const Rep1& lhs, const SizeQuantity<Rep2, Period>& rhs) {
+
+		return rhs * lhs;
+
+	}
+	template <typename Rep1, typename Period, typename Rep2, typename std::enable_if<!IsSizeQuantity<Rep2>::value, int>::type = 0>
+	constexpr SizeQuantity<typename std::common_type<Rep1, Rep2>::type, Period> operator/(const SizeQuantity<Rep1, Period>& lhs, const Rep2& rhs) {
+
+		return SizeQuantity<typename std::common_type<Rep1, Rep2>::type, Period>(lhs.Count() / rhs);
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr typename std::common_type<Rep1, Rep2>::type operator/(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		using Common = typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type;
+
+		return Common(lhs).Count() / Common(rhs).Count();
+
+	}
+
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator==(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		using Common = typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type;
+
+		return Common(lhs).Count() == Common(rhs).Count();
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator!=(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		return !(lhs == rhs);
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator<(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		using Common = typename std::common_type<SizeQuantity<Rep1, Period1>, SizeQuantity<Rep2, Period2>>::type;
+
+		return Common(lhs).Count() < Common(rhs).Count();
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator<=(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		return !(rhs < lhs);
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator>(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		return rhs < lhs;
+
+	}
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	constexpr bool operator>=(const SizeQuantity<Rep1, Period1>& lhs, const SizeQuantity<Rep2, Period2>& rhs) {
+
+		return !(lhs < rhs);
+
+	}
+
+	// Number of bytes in one unit of the given magnitude, taken from the same table as ByteSize's multipliers.
+	// Quantities stop at exa, since a zettabyte does not fit in std::ratio's std::intmax_t.
+	template <BytePrefix Prefix, int Magnitude>
+	using ByteRatio = std::ratio<static_cast<std::intmax_t>(UNIT_MULTIPLIERS[static_cast<int>(Prefix)][Magnitude])>;
+	template <BytePrefix Prefix, int Magnitude>
+	using BitRatio = std::ratio_multiply<ByteRatio<Prefix, Magnitude>, std::ratio<1, 8>>;
+
+	template <typename Rep> using bits = SizeQuantity<Rep, std::ratio<1, 8>>;
+	template <typename Rep> using bytes = SizeQuantity<Rep, std::ratio<1>>;
+
+	template <typename Rep> using kibibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 1>>;
+	template <typename Rep> using mebibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 2>>;
+	template <typename Rep> using gibibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 3>>;
+	template <typename Rep> using tebibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 4>>;
+	template <typename Rep> using pebibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 5>>;
+	template <typename Rep> using exbibytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Binary, 6>>;
+	template <typename Rep> using kilobytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 1>>;
+	template <typename Rep> using megabytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 2>>;
+	template <typename Rep> using gigabytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 3>>;
+	template <typename Rep> using terabytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 4>>;
+	template <typename Rep> using petabytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 5>>;
+	template <typename Rep> using exabytes = SizeQuantity<Rep, ByteRatio<BytePrefix::Decimal, 6>>;
+
+	template <typename Rep> using kibibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 1>>;
+	template <typename Rep> using mebibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 2>>;
+	template <typename Rep> using gibibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 3>>;
+	template <typename Rep> using tebibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 4>>;
+	template <typename Rep> using pebibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 5>>;
+	template <typename Rep> using exbibits = SizeQuantity<Rep, BitRatio<BytePrefix::Binary, 6>>;
+	template <typename Rep> using kilobits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 1>>;
+	template <typename Rep> using megabits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 2>>;
+	template <typename Rep> using gigabits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 3>>;
+	template <typename Rep> using terabits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 4>>;
+	template <typename Rep> using petabits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 5>>;
+	template <typename Rep> using exabits = SizeQuantity<Rep, BitRatio<BytePrefix::Decimal, 6>>;
+
+	inline namespace literals {
+		inline namespace size_literals {
+
+			constexpr bits<std::int64_t> operator""_bit(unsigned long long size) { return bits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr bits<double> operator""_bit(long double size) { return bits<double>(static_cast<double>(size)); }
+			constexpr bytes<std::int64_t> operator""_B(unsigned long long size) { return bytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr bytes<double> operator""_B(long double size) { return bytes<double>(static_cast<double>(size)); }
+
+			constexpr kibibytes<std::int64_t> operator""_KiB(unsigned long long size) { return kibibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr kibibytes<double> operator""_KiB(long double size) { return kibibytes<double>(static_cast<double>(size)); }
+			constexpr mebibytes<std::int64_t> operator""_MiB(unsigned long long size) { return mebibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr mebibytes<double> operator""_MiB(long double size) { return mebibytes<double>(static_cast<double>(size)); }
+			constexpr gibibytes<std::int64_t> operator""_GiB(unsigned long long size) { return gibibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr gibibytes<double> operator""_GiB(long double size) { return gibibytes<double>(static_cast<double>(size)); }
+			constexpr tebibytes<std::int64_t> operator""_TiB(unsigned long long size) { return tebibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr tebibytes<double> operator""_TiB(long double size) { return tebibytes<double>(static_cast<double>(size)); }
+			constexpr pebibytes<std::int64_t> operator""_PiB(unsigned long long size) { return pebibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr pebibytes<double> operator""_PiB(long double size) { return pebibytes<double>(static_cast<double>(size)); }
+			constexpr exbibytes<std::int64_t> operator""_EiB(unsigned long long size) { return exbibytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr exbibytes<double> operator""_EiB(long double size) { return exbibytes<double>(static_cast<double>(size)); }
+			constexpr kilobytes<std::int64_t> operator""_kB(unsigned long long size) { return kilobytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr kilobytes<double> operator""_kB(long double size) { return kilobytes<double>(static_cast<double>(size)); }
+			constexpr megabytes<std::int64_t> operator""_MB(unsigned long long size) { return megabytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr megabytes<double> operator""_MB(long double size) { return megabytes<double>(static_cast<double>(size)); }
+			constexpr gigabytes<std::int64_t> operator""_GB(unsigned long long size) { return gigabytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr gigabytes<double> operator""_GB(long double size) { return gigabytes<double>(static_cast<double>(size)); }
+			constexpr terabytes<std::int64_t> operator""_TB(unsigned long long size) { return terabytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr terabytes<double> operator""_TB(long double size) { return terabytes<double>(static_cast<double>(size)); }
+			constexpr petabytes<std::int64_t> operator""_PB(unsigned long long size) { return petabytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr petabytes<double> operator""_PB(long double size) { return petabytes<double>(static_cast<double>(size)); }
+			constexpr exabytes<std::int64_t> operator""_EB(unsigned long long size) { return exabytes<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr exabytes<double> operator""_EB(long double size) { return exabytes<double>(static_cast<double>(size)); }
+
+			constexpr kibibits<std::int64_t> operator""_Kibit(unsigned long long size) { return kibibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr kibibits<double> operator""_Kibit(long double size) { return kibibits<double>(static_cast<double>(size)); }
+			constexpr mebibits<std::int64_t> operator""_Mibit(unsigned long long size) { return mebibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr mebibits<double> operator""_Mibit(long double size) { return mebibits<double>(static_cast<double>(size)); }
+			constexpr gibibits<std::int64_t> operator""_Gibit(unsigned long long size) { return gibibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr gibibits<double> operator""_Gibit(long double size) { return gibibits<double>(static_cast<double>(size)); }
+			constexpr tebibits<std::int64_t> operator""_Tibit(unsigned long long size) { return tebibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr tebibits<double> operator""_Tibit(long double size) { return tebibits<double>(static_cast<double>(size)); }
+			constexpr pebibits<std::int64_t> operator""_Pibit(unsigned long long size) { return pebibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr pebibits<double> operator""_Pibit(long double size) { return pebibits<double>(static_cast<double>(size)); }
+			constexpr exbibits<std::int64_t> operator""_Eibit(unsigned long long size) { return exbibits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr exbibits<double> operator""_Eibit(long double size) { return exbibits<double>(static_cast<double>(size)); }
+			constexpr kilobits<std::int64_t> operator""_kbit(unsigned long long size) { return kilobits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr kilobits<double> operator""_kbit(long double size) { return kilobits<double>(static_cast<double>(size)); }
+			constexpr megabits<std::int64_t> operator""_Mbit(unsigned long long size) { return megabits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr megabits<double> operator""_Mbit(long double size) { return megabits<double>(static_cast<double>(size)); }
+			constexpr gigabits<std::int64_t> operator""_Gbit(unsigned long long size) { return gigabits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr gigabits<double> operator""_Gbit(long double size) { return gigabits<double>(static_cast<double>(size)); }
+			constexpr terabits<std::int64_t> operator""_Tbit(unsigned long long size) { return terabits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr terabits<double> operator""_Tbit(long double size) { return terabits<double>(static_cast<double>(size)); }
+			constexpr petabits<std::int64_t> operator""_Pbit(unsigned long long size) { return petabits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr petabits<double> operator""_Pbit(long double size) { return petabits<double>(static_cast<double>(size)); }
+			constexpr exabits<std::int64_t> operator""_Ebit(unsigned long long size) { return exabits<std::int64_t>(static_cast<std::int64_t>(size)); }
+			constexpr exabits<double> operator""_Ebit(long double size) { return exabits<double>(static_cast<double>(size)); }
+
+		}
+	}
+
+}
+
+namespace std {
+
+	template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+	struct common_type<hvn3::SizeQuantity<Rep1, Period1>, hvn3::SizeQuantity<Rep2, Period2>> {
+		using type = hvn3::SizeQuantity<typename common_type<Rep1, Rep2>::type,
+			ratio<gcd(Period1::num, Period2::num), lcm(Period1::den, Period2::den)>>;
+	};
+
+}
\ No newline at end of file
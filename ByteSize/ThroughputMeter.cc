@@ -0,0 +1,88 @@
+#include "ThroughputMeter.h"
+#include <cmath>
+
+namespace hvn3 {
+
+	BYTESIZE_INLINE ThroughputMeter::ThroughputMeter(clock::duration averagingTime, std::size_t windowIntervals, clock::time_point start) :
+		_averaging_seconds(std::chrono::duration<double>(averagingTime).count()),
+		_last_update(start),
+		_last_total(0),
+		_has_average(false),
+		_window(windowIntervals == 0 ? 1 : windowIntervals, Interval{ 0, clock::duration::zero() }),
+		_window_next(0),
+		_window_bits(0),
+		_window_duration(clock::duration::zero()),
+		_instantaneous_rate(0.0),
+		_average_rate(0.0),
+		_window_rate(0.0) {
+	}
+
+	BYTESIZE_INLINE void ThroughputMeter::Record(const ByteSize& size) {
+
+		_recorded.Add(size);
+
+	}
+
+	BYTESIZE_INLINE void ThroughputMeter::Update(clock::time_point now) {
+
+		clock::duration elapsed = now - _last_update;
+
+		if (elapsed <= clock::duration::zero())
+			return;
+
+		BitCount total = _recorded.Load().ExactBits();
+		BitCount bits = total - _last_total;
+		double seconds = std::chrono::duration<double>(elapsed).count();
+		double rate = static_cast<double>(bits) / seconds;
+
+		_last_update = now;
+		_last_total = total;
+
+		// Weighting by elapsed time keeps the average's time constant the same however irregularly Update is called.
+		double average = rate;
+
+		if (_has_average) {
+
+			double previous = _average_rate.load(std::memory_order_relaxed);
+
+			average = previous + (rate - previous) * (1.0 - std::exp(-seconds / _averaging_seconds));
+
+		}
+
+		_has_average = true;
+
+		Interval& oldest = _window[_window_next];
+
+		_window_bits += bits - oldest.bits;
+		_window_duration += elapsed - oldest.duration;
+		oldest = Interval{ bits, elapsed };
+		_window_next = (_window_next + 1) % _window.size();
+
+		_instantaneous_rate.store(rate, std::memory_order_relaxed);
+		_average_rate.store(average, std::memory_order_relaxed);
+		_window_rate.store(static_cast<double>(_window_bits) / std::chrono::duration<double>(_window_duration).count(), std::memory_order_relaxed);
+
+	}
+
+	BYTESIZE_INLINE ByteSize ThroughputMeter::Total() const {
+
+		return _recorded.Load();
+
+	}
+	BYTESIZE_INLINE ByteRate ThroughputMeter::InstantaneousRate() const {
+
+		return ByteRate::FromBitsPerSecond(_instantaneous_rate.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE ByteRate ThroughputMeter::AverageRate() const {
+
+		return ByteRate::FromBitsPerSecond(_average_rate.load(std::memory_order_relaxed));
+
+	}
+	BYTESIZE_INLINE ByteRate ThroughputMeter::WindowRate() const {
+
+		return ByteRate::FromBitsPerSecond(_window_rate.load(std::memory_order_relaxed));
+
+	}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "AtomicSize.h"
+#include "Rate.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hvn3 {
+
+	// Measures the rate at which bytes pass through a code path.
+	// Record can be called from any number of threads and only adds to a per-CPU counter. Update folds the recorded bytes into the
+	// instantaneous, moving average (EWMA) and sliding window rates, and should be called periodically (e.g. once per second) by one thread
+	// at a time. The rates can be read from any thread.
+	class ThroughputMeter {
+
+	public:
+		typedef std::chrono::steady_clock clock;
+
+		// averagingTime is the time constant of the moving average, and windowIntervals the number of Update intervals the sliding window
+		// covers.
+		explicit ThroughputMeter(clock::duration averagingTime = std::chrono::seconds(10), std::size_t windowIntervals = 60, clock::time_point start = clock::now());
+		ThroughputMeter(const ThroughputMeter&) = delete;
+
+		void Record(const ByteSize& size);
+
+		void Update(clock::time_point now = clock::now());
+
+		// Returns everything recorded so far, including bytes not yet folded in by Update.
+		ByteSize Total() const;
+		// Returns the rate over the most recent Update interval.
+		ByteRate InstantaneousRate() const;
+		// Returns the exponentially weighted moving average of the rate.
+		ByteRate AverageRate() const;
+		// Returns the rate over the last windowIntervals Update intervals.
+		ByteRate WindowRate() const;
+
+		ThroughputMeter& operator=(const ThroughputMeter&) = delete;
+
+	private:
+		struct Interval {
+			BitCount bits;
+			clock::duration duration;
+		};
+
+		ShardedAtomicByteSize _recorded;
+
+		double _averaging_seconds;
+		clock::time_point _last_update;
+		BitCount _last_total;
+		bool _has_average;
+
+		std::vector<Interval> _window;
+		std::size_t _window_next;
+		BitCount _window_bits;
+		clock::duration _window_duration;
+
+		std::atomic<double> _instantaneous_rate;
+		std::atomic<double> _average_rate;
+		std::atomic<double> _window_rate;
+
+	};
+
+}
+
+#if defined(BYTESIZE_HEADER_ONLY)
+#include "ThroughputMeter.cc"
+#endif
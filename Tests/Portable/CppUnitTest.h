@@ -0,0 +1,127 @@
+#pragma once
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A minimal stand-in for the parts of the Visual Studio CppUnitTest framework used by the tests, so they can be built and run by CMake on
+// any platform. TEST_METHOD registers each test with a global list, which RunAllTests in TestMain.cc works through.
+
+namespace Microsoft {
+	namespace VisualStudio {
+		namespace CppUnitTestFramework {
+
+			class AssertFailedException :
+				public std::runtime_error {
+
+			public:
+				explicit AssertFailedException(const std::string& message) :
+					std::runtime_error(message) {
+				}
+
+			};
+
+			class Assert {
+
+			public:
+				template <typename T>
+				static void AreEqual(const T& expected, const T& actual, const wchar_t* = nullptr) {
+
+					if (!(expected == actual)) {
+
+						std::ostringstream stream;
+
+						stream << "AreEqual failed: expected <" << expected << "> actual <" << actual << ">";
+
+						throw AssertFailedException(stream.str());
+
+					}
+
+				}
+				static void AreEqual(double expected, double actual, double tolerance, const wchar_t* = nullptr) {
+
+					if (!(std::fabs(expected - actual) <= tolerance)) {
+
+						std::ostringstream stream;
+
+						stream << "AreEqual failed: expected <" << expected << "> actual <" << actual << "> tolerance <" << tolerance << ">";
+
+						throw AssertFailedException(stream.str());
+
+					}
+
+				}
+				static void IsTrue(bool condition, const wchar_t* = nullptr) {
+
+					if (!condition)
+						throw AssertFailedException("IsTrue failed");
+
+				}
+				static void IsFalse(bool condition, const wchar_t* = nullptr) {
+
+					if (condition)
+						throw AssertFailedException("IsFalse failed");
+
+				}
+				template <typename ExceptionType, typename Function>
+				static void ExpectException(Function function, const wchar_t* = nullptr) {
+
+					try {
+						function();
+					}
+					catch (const ExceptionType&) {
+						return;
+					}
+
+					throw AssertFailedException("ExpectException failed");
+
+				}
+
+			};
+
+			struct TestMethodInfo {
+				std::string name;
+				std::function<void()> method;
+			};
+
+			inline std::vector<TestMethodInfo>& RegisteredTestMethods() {
+
+				static std::vector<TestMethodInfo> methods;
+
+				return methods;
+
+			}
+
+			template <typename TestClassType>
+			class TestClass {
+
+			public:
+				typedef TestClassType ThisClass;
+
+			};
+
+			struct TestMethodRegistrar {
+
+				TestMethodRegistrar(const char* name, std::function<void()> method) {
+					RegisteredTestMethods().push_back({ name, std::move(method) });
+				}
+
+			};
+
+		}
+	}
+}
+
+#define TEST_CLASS(className) class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName) \
+	struct methodName##Registrar { \
+		methodName##Registrar() { \
+			static ::Microsoft::VisualStudio::CppUnitTestFramework::TestMethodRegistrar registrar(#methodName, [] { ThisClass().methodName(); }); \
+		} \
+	}; \
+	inline static methodName##Registrar methodName##_registrar; \
+	void methodName()
@@ -0,0 +1,39 @@
+#include "CppUnitTest.h"
+#include <exception>
+#include <iostream>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// Runs every registered test, or only those whose names contain the first argument, and returns non-zero if any of them failed.
+int main(int argc, char* argv[]) {
+
+	std::string filter = argc > 1 ? argv[1] : "";
+	std::size_t run = 0;
+	std::size_t failed = 0;
+
+	for (const TestMethodInfo& test : RegisteredTestMethods()) {
+
+		if (test.name.find(filter) == std::string::npos)
+			continue;
+
+		++run;
+
+		try {
+			test.method();
+		}
+		catch (const std::exception& ex) {
+
+			++failed;
+
+			std::cout << "FAILED " << test.name << ": " << ex.what() << '\n';
+
+		}
+
+	}
+
+	std::cout << run << " tests, " << failed << " failed\n";
+
+	return failed == 0 && run > 0 ? 0 : 1;
+
+}
@@ -1,5 +1,26 @@
 #include "CppUnitTest.h"
 #include "ByteSize.h"
+#include "BitSize.h"
+#include "AtomicSize.h"
+#include "Rate.h"
+#include "ThroughputMeter.h"
+#include "ByteSizeHistogram.h"
+#include "SizeArray.h"
+#include "SizeClassMap.h"
+#include "MemoryAccount.h"
+#include "MemorySampler.h"
+#include "NetworkSampler.h"
+#include "SizeLogger.h"
+#include "SharedCounters.h"
+#include "MetricsExporter.h"
+#include "SizeFormat.h"
+#include "RateLimiter.h"
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -39,6 +60,36 @@ public:
 
 	}
 
+	TEST_METHOD(TestMethodToCharsKilobytes) {
+
+		hvn3::ByteSize bs = hvn3::ByteSize::FromKilobytes(1.5);
+		char buffer[16];
+		std::to_chars_result result = bs.ToChars(buffer, buffer + sizeof(buffer), 1);
+
+		Assert::IsTrue(result.ec == std::errc());
+		Assert::AreEqual(std::string("1.5 KiB"), std::string(buffer, result.ptr));
+
+	}
+
+	TEST_METHOD(TestMethodToCharsBufferTooSmall) {
+
+		hvn3::ByteSize bs = hvn3::ByteSize::FromKilobytes(1.5);
+		char buffer[6];
+
+		Assert::IsTrue(bs.ToChars(buffer, buffer + sizeof(buffer), 2).ec == std::errc::value_too_large);
+
+	}
+
+	TEST_METHOD(TestMethodStreamBitSize) {
+
+		std::stringstream stream;
+
+		stream << hvn3::BitSize(1024);
+
+		Assert::AreEqual(std::string("8.00 Kibit"), stream.str());
+
+	}
+
 	TEST_METHOD(TestMethodParseKilobytes) {
 
 		hvn3::ByteSize bs = hvn3::ByteSize::Parse("1.5 KiB");
@@ -47,6 +98,841 @@ public:
 
 	}
 
+	TEST_METHOD(TestMethodParseLongAndShortForms) {
+
+		Assert::AreEqual(3000.0, hvn3::ByteSize::Parse("3 kilobytes").Bytes());
+		Assert::AreEqual(4096.0, hvn3::ByteSize::Parse("4K").Bytes());
+		Assert::AreEqual(2000000000.0, hvn3::ByteSize::Parse("2GB").Bytes());
+		Assert::AreEqual(1250000000.0, hvn3::BitSize::Parse("10 Gbit").Bytes());
+
+	}
+
+	TEST_METHOD(TestMethodTryParseErrorPosition) {
+
+		hvn3::ByteSize bs(0);
+		hvn3::ParseResult result = hvn3::ByteSize::TryParse(std::string_view("12 XB"), bs);
+
+		Assert::IsTrue(result.error == hvn3::ParseError::InvalidSuffix);
+		Assert::AreEqual(std::size_t(3), result.position);
+
+		result = hvn3::ByteSize::TryParse(std::string_view("KiB"), bs);
+
+		Assert::IsTrue(result.error == hvn3::ParseError::InvalidNumber);
+		Assert::AreEqual(std::size_t(0), result.position);
+
+	}
+
+	TEST_METHOD(TestMethodExactIntegerArithmetic) {
+
+		// 2^53 + 1 bytes cannot be represented by a double, but the bit count is exact.
+		hvn3::ByteSize bs(9007199254740993LL);
+
+		bs += hvn3::ByteSize(1);
+
+		Assert::IsTrue(bs.ExactBits() == 9007199254740994LL * 8);
+		Assert::IsTrue(bs != hvn3::ByteSize(9007199254740993LL));
+
+		// Whole numbers are parsed exactly too, with or without a unit.
+		Assert::IsTrue(hvn3::ByteSize::Parse("9007199254740993 B").ExactBits() == 9007199254740993LL * 8);
+		Assert::IsTrue(hvn3::ByteSize::Parse("-9007199254740993").ExactBits() == -9007199254740993LL * 8);
+		Assert::IsTrue(hvn3::ByteSize::Parse("900719925474099 kB").ExactBits() == 900719925474099LL * 1000 * 8);
+		Assert::IsTrue(hvn3::BitSize::Parse("9007199254740993 b").ExactBits() == 9007199254740993LL);
+		Assert::IsTrue(hvn3::ByteSize::Parse("1000000000000000 YB") == hvn3::ByteSize::MaxValue());
+
+		hvn3::BitCount counts[1];
+		std::size_t invalid_rows[1];
+
+		hvn3::ByteSize::ParseMany("9007199254740993 B\n", counts, 1, invalid_rows, 1);
+
+		Assert::IsTrue(counts[0] == 9007199254740993LL * 8);
+
+	}
+
+	TEST_METHOD(TestMethodRoundsToNearestBit) {
+
+		Assert::IsTrue(hvn3::ByteSize(0.01).ExactBits() == 1);
+		Assert::IsTrue(hvn3::ByteSize(-0.01).ExactBits() == -1);
+		Assert::AreEqual(0.25, hvn3::RoundBytesToNearestBit(0.2));
+
+	}
+
+	TEST_METHOD(TestMethodArithmeticSaturates) {
+
+		hvn3::ByteSize bs = hvn3::ByteSize::MaxValue();
+
+		bs += hvn3::ByteSize(1);
+
+		Assert::IsTrue(bs == hvn3::ByteSize::MaxValue());
+
+	}
+
+	TEST_METHOD(TestMethodStaticPrefix) {
+
+		hvn3::DecimalByteSize bs(1500);
+
+		Assert::AreEqual(1.5, bs.Kilobytes());
+		Assert::AreEqual(std::string("1.50 kB"), bs.ToString());
+		Assert::IsTrue(sizeof(hvn3::DecimalByteSize) == sizeof(hvn3::BitCount));
+
+	}
+
+	TEST_METHOD(TestMethodConvertByteSizeToBitSize) {
+
+		hvn3::BitSize bs(hvn3::ByteSize::FromKilobytes(1.0));
+
+		Assert::AreEqual(8.0, bs.Kilobits());
+		Assert::AreEqual(std::string("100.00 b"), hvn3::BitSize::FromBits(100.0).ToString());
+
+	}
+
+	TEST_METHOD(TestMethodQuantityConversions) {
+
+		using namespace hvn3::literals;
+
+		constexpr hvn3::kibibytes<std::int64_t> buffer = 64_KiB;
+		constexpr hvn3::bytes<std::int64_t> buffer_bytes = buffer;
+		static_assert(buffer_bytes.Count() == 65536, "64 KiB should be 65536 bytes");
+
+		constexpr auto total = 1_MiB + 512_KiB;
+		static_assert(std::is_same<decltype(total), const hvn3::kibibytes<std::int64_t>>::value, "common type should be kibibytes");
+		Assert::AreEqual(std::int64_t(1536), total.Count());
+
+		Assert::AreEqual(1.5, hvn3::QuantityCast<hvn3::mebibytes<double>>(total).Count());
+
+	}
+
+	TEST_METHOD(TestMethodQuantityToByteSize) {
+
+		using namespace hvn3::literals;
+
+		constexpr hvn3::BitSize link = 10_Gbit;
+		constexpr hvn3::ByteSize limit = 64_KiB;
+
+		Assert::AreEqual(std::string("10.00 Gbit"), link.ToString());
+		Assert::AreEqual(std::string("64.00 KiB"), limit.ToString());
+
+	}
+
+	TEST_METHOD(TestMethodLargestUnit) {
+
+		using namespace hvn3::literals;
+
+		hvn3::UnitSelection unit = hvn3::ByteSize(1536).LargestUnit();
+
+		Assert::AreEqual(1, unit.magnitude);
+		Assert::AreEqual(1.5, unit.value);
+		Assert::AreEqual(std::string("KiB"), std::string(unit.symbol));
+		Assert::AreEqual(-1, hvn3::ByteSize(0).LargestUnit().magnitude);
+		Assert::AreEqual(std::string("999.00 kB"), hvn3::ByteSize(999000, hvn3::BytePrefix::Decimal).ToString());
+		Assert::AreEqual(std::string("1.00 MB"), hvn3::ByteSize(1000000, hvn3::BytePrefix::Decimal).ToString());
+
+		Assert::AreEqual(std::string("1.00 EB"), hvn3::ByteSize::Parse("1 EB").ToString());
+		Assert::AreEqual(std::string("3.00 Eibit"), hvn3::BitSize::Parse("3 exbibits").ToString());
+		Assert::AreEqual(1.0, hvn3::ByteSize(1_EB).Exabytes());
+#if defined(BYTESIZE_INT128) && defined(__SIZEOF_INT128__)
+		Assert::AreEqual(std::string("1.50 ZB"), hvn3::ByteSize::Parse("1.5 zettabytes").ToString());
+		Assert::AreEqual(std::string("2.00 YiB"), hvn3::ByteSize::Parse("2 YiB").ToString());
+#endif
+
+	}
+
+	TEST_METHOD(TestMethodAtomicSize) {
+
+		hvn3::AtomicByteSize total;
+		hvn3::ShardedAtomicByteSize sharded(hvn3::BytePrefix::Binary, 4);
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&] {
+				for (int j = 0; j < 10000; ++j) {
+					total += 3;
+					sharded += 3;
+				}
+			});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		Assert::IsTrue(total.Load() == hvn3::ByteSize(120000));
+		Assert::IsTrue(total.FetchSub(hvn3::ByteSize(120000)) == hvn3::ByteSize(120000));
+		Assert::IsTrue(total.Load() == hvn3::ByteSize(0));
+
+		Assert::AreEqual(std::size_t(4), sharded.ShardCount());
+		Assert::AreEqual(std::string("117.19 KiB"), sharded.ToString());
+		Assert::IsTrue(sharded.Reset() == hvn3::ByteSize(120000));
+		Assert::IsTrue(sharded.Load() == hvn3::ByteSize(0));
+
+	}
+
+	TEST_METHOD(TestMethodRate) {
+
+		hvn3::ByteRate disk(hvn3::ByteSize::FromMegabytes(850), std::chrono::seconds(1));
+		hvn3::BitRate link = hvn3::BitRate::FromBitsPerSecond(12.4e9, hvn3::BytePrefix::Decimal);
+
+		Assert::AreEqual(std::string("850.00 MiB/s"), disk.ToString());
+		Assert::AreEqual(std::string("12.40 Gbit/s"), link.ToString());
+		Assert::AreEqual(std::string("6.80 Gbit/s"), hvn3::BitRate(hvn3::ByteRate::FromBytesPerSecond(850e6, hvn3::BytePrefix::Decimal)).ToString());
+		Assert::IsTrue(disk.SizeOver(std::chrono::seconds(2)) == hvn3::ByteSize::FromMegabytes(1700));
+
+		Assert::IsTrue(hvn3::ByteRate::Parse("200 MiB/s") == hvn3::ByteRate::FromUnitsPerSecond(2, 200));
+		Assert::AreEqual(1e8, hvn3::BitRate::Parse("100 Mbps").BitsPerSecond());
+		Assert::AreEqual(std::string("10.00 Gbit/s"), hvn3::BitRate::Parse("10 Gbit/sec").ToString());
+
+		hvn3::ByteRate rate;
+
+		Assert::IsTrue(hvn3::ByteRate::TryParse("200 MiB", rate).error == hvn3::ParseError::InvalidSuffix);
+
+	}
+
+	TEST_METHOD(TestMethodThroughputMeter) {
+
+		hvn3::ThroughputMeter::clock::time_point start;
+		hvn3::ThroughputMeter meter(std::chrono::seconds(10), 2, start);
+
+		meter.Record(hvn3::ByteSize::FromMegabytes(100));
+		meter.Update(start + std::chrono::seconds(1));
+
+		Assert::AreEqual(std::string("100.00 MiB/s"), meter.InstantaneousRate().ToString());
+		Assert::AreEqual(std::string("100.00 MiB/s"), meter.AverageRate().ToString());
+
+		meter.Record(hvn3::ByteSize::FromMegabytes(300));
+		meter.Update(start + std::chrono::seconds(2));
+
+		Assert::AreEqual(std::string("300.00 MiB/s"), meter.InstantaneousRate().ToString());
+		Assert::AreEqual(std::string("200.00 MiB/s"), meter.WindowRate().ToString());
+		Assert::IsTrue(meter.AverageRate() > hvn3::ByteRate::FromUnitsPerSecond(2, 100));
+		Assert::IsTrue(meter.AverageRate() < hvn3::ByteRate::FromUnitsPerSecond(2, 300));
+
+		meter.Update(start + std::chrono::seconds(4));
+
+		Assert::AreEqual(std::string("100.00 MiB/s"), meter.WindowRate().ToString());
+		Assert::AreEqual(std::string("400.00 MiB"), meter.Total().ToString());
+
+	}
+
+	TEST_METHOD(TestMethodHistogram) {
+
+		hvn3::ByteSizeHistogram histogram;
+
+		for (int i = 1; i <= 100; ++i)
+			histogram.Record(hvn3::ByteSize(i));
+
+		Assert::AreEqual(std::uint64_t(100), histogram.Count());
+		Assert::AreEqual(std::string("31.00 B"), histogram.Percentile(31).ToString());
+		Assert::IsTrue(histogram.Percentile(50) >= hvn3::ByteSize(50) && histogram.Percentile(50) <= hvn3::ByteSize(51));
+		Assert::AreEqual(std::string("100.00 B"), histogram.Percentile(100).ToString());
+		Assert::AreEqual(std::string("50.50 B"), histogram.Mean().ToString());
+
+		hvn3::ByteSizeHistogram other;
+
+		other.Record(hvn3::ByteSize::FromMegabytes(16), 2);
+		histogram.Merge(other);
+
+		Assert::AreEqual(std::uint64_t(102), histogram.Count());
+		Assert::AreEqual(std::string("16.00 MiB"), histogram.Quantile(0.99).ToString());
+		Assert::AreEqual(std::string("count 102, p50 51.00 B, p99 16.00 MiB, p99.9 16.00 MiB, max 16.00 MiB"), histogram.ToString());
+
+		// Every unit starts a bucket, so percentiles at unit boundaries are exact.
+		Assert::AreEqual(std::uint64_t(1024), hvn3::ByteSizeHistogram::BucketLowerBound(hvn3::ByteSizeHistogram::BucketIndex(1024, hvn3::BytePrefix::Binary), hvn3::BytePrefix::Binary));
+		Assert::AreEqual(std::uint64_t(1000), hvn3::ByteSizeHistogram::BucketLowerBound(hvn3::ByteSizeHistogram::BucketIndex(1000, hvn3::BytePrefix::Decimal), hvn3::BytePrefix::Decimal));
+		Assert::AreEqual(std::uint64_t(1000000), hvn3::ByteSizeHistogram::BucketLowerBound(hvn3::ByteSizeHistogram::BucketIndex(1000000, hvn3::BytePrefix::Decimal), hvn3::BytePrefix::Decimal));
+		Assert::AreEqual(std::uint64_t(1099999), hvn3::ByteSizeHistogram::BucketUpperBound(hvn3::ByteSizeHistogram::BucketIndex(1000000, hvn3::BytePrefix::Decimal), hvn3::BytePrefix::Decimal));
+
+		Assert::ExpectException<std::invalid_argument>([&histogram] { histogram.Merge(hvn3::ByteSizeHistogram(hvn3::BytePrefix::Decimal)); });
+
+	}
+
+	TEST_METHOD(TestMethodSizeArray) {
+
+		const double bytes[] = { 1536.0, 0.3, -0.3, 1048576.0, 1e300 };
+		hvn3::ByteSizeArray array = hvn3::ByteSizeArray::FromBytes(bytes, 5);
+
+		for (std::size_t i = 0; i < 5; ++i)
+			Assert::IsTrue(array[i] == hvn3::ByteSize(bytes[i]));
+
+		double rounded[5];
+
+		hvn3::RoundBytesToNearestBit(bytes, 5, rounded);
+
+		for (std::size_t i = 0; i < 5; ++i)
+			Assert::AreEqual(hvn3::RoundBytesToNearestBit(bytes[i]), rounded[i]);
+
+		array.Resize(4);
+
+		std::vector<double> kilobytes = array.Units(1);
+
+		Assert::AreEqual(hvn3::ByteSize(1536).Kilobytes(), kilobytes[0]);
+		Assert::AreEqual(1024.0, kilobytes[3]);
+		Assert::AreEqual(std::string("-3.00 b"), array.Min().ToString());
+		Assert::AreEqual(std::string("1.00 MiB"), array.Max().ToString());
+
+		array += hvn3::ByteSize(1);
+		array -= array;
+
+		Assert::IsTrue(array.Sum() == hvn3::ByteSize(0));
+
+		// Large enough to be split between threads, with a sum that would overflow a naive int64 accumulator partway through.
+		hvn3::ByteSizeArray large(std::size_t(1) << 18);
+
+		for (std::size_t i = 0; i < large.Size(); ++i)
+			large.Data()[i] = i % 2 == 0 ? hvn3::MaxBitCount() / 2 : -(hvn3::MaxBitCount() / 2);
+
+		large.Set(7, hvn3::ByteSize(8));
+
+		Assert::IsTrue(large.Sum(4) == large.Sum(1));
+		Assert::IsTrue(large.Sum(0) == hvn3::ByteSize::FromExactBits(hvn3::MaxBitCount() / 2 + 64));
+		Assert::IsTrue(large.Min(4) == hvn3::ByteSize::FromExactBits(-(hvn3::MaxBitCount() / 2)));
+		Assert::AreEqual(large.Sum().Bits() / large.Size(), large.Mean(4).Bits(), 1.0);
+
+		// Small blocks carry the low sum into the high sum after every few elements, as billions of elements would with the default size.
+		// Every count has all of its low half set, so each block carries.
+		std::vector<hvn3::BitCount> counts(1000, hvn3::MaxBitCount() / 1024);
+		hvn3::internal::BitCountTotals totals = hvn3::internal::ReduceBitCounts(counts.data(), counts.size(), 1, 4);
+
+		Assert::IsTrue(totals.sum == hvn3::MaxBitCount() / 1024 * 1000);
+		Assert::IsTrue(totals.sum == hvn3::internal::ReduceBitCounts(counts.data(), counts.size(), 1).sum);
+		Assert::AreEqual(static_cast<double>(hvn3::MaxBitCount() / 1024), totals.mean, static_cast<double>(hvn3::MaxBitCount()) * 1e-12);
+
+	}
+
+	TEST_METHOD(TestMethodConstexprArithmetic) {
+
+		constexpr hvn3::ByteSize a(1536);
+		constexpr hvn3::ByteSize b = hvn3::ByteSize::FromKilobytes(0.5);
+
+		static_assert((a + b).ExactBits() == 2048 * 8, "Addition should be constexpr");
+		static_assert((a - b).Kilobytes() == 1.0, "Subtraction and accessors should be constexpr");
+		static_assert(a > b && b <= a && a != b, "Comparisons should be constexpr");
+		static_assert(noexcept(a + b) && noexcept(a < b) && noexcept(a.Bytes()), "Arithmetic should be noexcept");
+		static_assert(hvn3::ByteSize::FromExactBits(hvn3::MaxBitCount()) + a == hvn3::ByteSize::MaxValue(), "Addition should saturate");
+
+		hvn3::ByteSize c = a;
+
+		c += b;
+		c.AddKilobytes(1);
+
+		Assert::AreEqual(3.0, c.Kilobytes());
+
+	}
+
+	TEST_METHOD(TestMethodSizeClassMap) {
+
+		hvn3::SizeClassMap classes({ hvn3::ByteSize::Parse("8 KiB"), hvn3::ByteSize::Parse("64 KiB"), hvn3::ByteSize::Parse("1 MiB"), hvn3::ByteSize::Parse("1.5 MiB") });
+
+		Assert::AreEqual(std::size_t(4), classes.ClassCount());
+		Assert::AreEqual(std::size_t(0), classes.ClassIndex(hvn3::ByteSize(1)));
+		Assert::AreEqual(std::size_t(0), classes.ClassIndex(hvn3::ByteSize(8192)));
+		Assert::AreEqual(std::size_t(1), classes.ClassIndex(hvn3::ByteSize(8193)));
+		Assert::AreEqual(std::size_t(3), classes.ClassIndex(hvn3::ByteSize::FromMegabytes(1.25)));
+		Assert::AreEqual(std::size_t(4), classes.ClassIndex(hvn3::ByteSize::FromMegabytes(2)));
+		Assert::AreEqual(std::string("64.00 KiB"), classes.RoundUp(hvn3::ByteSize::FromKilobytes(48)).ToString());
+		Assert::AreEqual(0.25, classes.Fragmentation(hvn3::ByteSize::FromKilobytes(48)));
+		Assert::AreEqual(std::string("8.00 KiB, 64.00 KiB, 1.00 MiB, 1.50 MiB"), classes.ToString());
+
+		// Classes one byte apart still map exactly.
+		hvn3::SizeClassMap close({ hvn3::ByteSize(1000), hvn3::ByteSize(1001), hvn3::ByteSize(1002) });
+
+		Assert::AreEqual(std::size_t(0), close.ClassIndex(1000));
+		Assert::AreEqual(std::size_t(1), close.ClassIndex(1001));
+		Assert::AreEqual(std::size_t(2), close.ClassIndex(1002));
+
+		Assert::ExpectException<std::invalid_argument>([] { hvn3::SizeClassMap({ hvn3::ByteSize(64), hvn3::ByteSize(32) }); });
+
+	}
+
+	TEST_METHOD(TestMethodMemoryAccount) {
+
+		hvn3::MemoryAccount account("test", 0);
+
+		{
+			hvn3::AccountingAllocator<char> allocator(account);
+			std::vector<char, hvn3::AccountingAllocator<char>> buffer(allocator);
+
+			buffer.reserve(1024);
+
+			Assert::AreEqual(std::string("1.00 KiB"), account.Live().ToString());
+
+		}
+
+		Assert::AreEqual(0.0, account.Live().Bytes());
+		Assert::AreEqual(std::string("1.00 KiB"), account.Peak().ToString());
+		Assert::AreEqual(std::uint64_t(1), account.Allocations());
+
+		hvn3::AccountingMemoryResource resource(account);
+		void* pointer = resource.allocate(2048);
+
+		resource.deallocate(pointer, 2048);
+
+		Assert::AreEqual(std::string("test: live 0.00 b, peak 2.00 KiB, total 3.00 KiB in 2 allocations"), account.ToString());
+
+		// Counts made by other threads are folded when they reach the threshold or the thread exits.
+		hvn3::MemoryAccount threaded("threaded");
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&threaded] {
+				for (int j = 0; j < 1000; ++j)
+					threaded.Allocate(100);
+			});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		Assert::AreEqual(400000.0, threaded.Total().Bytes());
+		Assert::AreEqual(std::uint64_t(4000), threaded.Allocations());
+
+		// Accounts reuse the slots of destroyed ones, without inheriting counts that were still pending in them.
+		for (int i = 0; i < 100; ++i) {
+
+			hvn3::MemoryAccount temporary("temporary");
+
+			temporary.Allocate(100);
+
+		}
+
+		hvn3::MemoryAccount reused("reused");
+
+		reused.Allocate(10);
+		reused.Flush();
+
+		Assert::AreEqual(10.0, reused.Live().Bytes());
+		Assert::AreEqual(std::uint64_t(1), reused.Allocations());
+
+		// A thread_local container constructed before the thread's first counted allocation is destroyed after the thread's counters, and
+		// its deallocation is counted directly.
+		hvn3::MemoryAccount late("late");
+
+		std::thread([&late] {
+			thread_local std::vector<char, hvn3::AccountingAllocator<char>> buffer{ hvn3::AccountingAllocator<char>(late) };
+			buffer.resize(100);
+		}).join();
+
+		late.Flush();
+
+		Assert::AreEqual(0.0, late.Live().Bytes());
+		Assert::AreEqual(100.0, late.Total().Bytes());
+
+	}
+
+	TEST_METHOD(TestMethodMemorySampler) {
+
+		hvn3::MemorySampler sampler;
+		hvn3::MemorySample sample;
+
+#if defined(__linux__)
+
+		Assert::IsTrue(sampler.Sample(sample));
+		Assert::IsTrue(sample.resident.Bytes() > 0);
+		Assert::IsTrue(sample.virtual_size >= sample.resident);
+		Assert::IsTrue(sample.resident_peak.Bytes() > 0);
+		Assert::IsTrue(sample.system_total >= sample.system_available);
+		Assert::IsTrue(sampler.Resident().Bytes() > 0);
+		Assert::IsTrue(sampler.Available() <= sample.system_total);
+
+#else
+
+		Assert::IsFalse(sampler.Sample(sample));
+		Assert::IsTrue(sample.cgroup_limit == hvn3::ByteSize::MaxValue());
+		Assert::IsTrue(sampler.Available() == hvn3::ByteSize::MaxValue());
+
+#endif
+
+	}
+
+	TEST_METHOD(TestMethodNetworkSampler) {
+
+		hvn3::NetworkSampler::clock::time_point now = hvn3::NetworkSampler::clock::now();
+		hvn3::NetworkSampler sampler;
+
+		sampler.Sample(now);
+
+		// The first sample of an interface reports no traffic.
+		for (const hvn3::InterfaceSample& sample : sampler.Interfaces()) {
+
+			Assert::IsTrue(sample.present);
+			Assert::AreEqual(0.0, sample.received.Bits());
+			Assert::AreEqual(0.0, sample.receive_rate.BitsPerSecond());
+
+		}
+
+		sampler.Sample(now + std::chrono::milliseconds(100));
+
+		for (const hvn3::InterfaceSample& sample : sampler.Interfaces())
+			Assert::AreEqual(sample.received.Bytes() * 10, sample.receive_rate.BytesPerSecond(), 1e-6);
+
+		hvn3::NetworkSampler missing({ "no-such-interface" });
+
+		Assert::AreEqual(std::size_t(1), missing.Sample().size());
+		Assert::IsFalse(missing.Find("no-such-interface")->present);
+		Assert::IsTrue(missing.Find("eth0") == nullptr);
+
+	}
+
+	TEST_METHOD(TestMethodSizeLogger) {
+
+		std::vector<std::string> lines;
+
+		{
+			hvn3::SizeLogger logger([&lines](std::string_view line) { lines.emplace_back(line); });
+
+			Assert::IsTrue(logger.Log("read", hvn3::ByteSize(1536)));
+			Assert::IsTrue(logger.Log("sent", hvn3::BitSize(125), 1));
+
+			logger.Flush();
+
+			Assert::AreEqual(std::size_t(2), lines.size());
+			Assert::AreEqual(std::string("read 1.50 KiB"), lines[0]);
+			Assert::AreEqual(std::string("sent 1000.0 b"), lines[1]);
+
+			// Precisions are clamped rather than wrapped, so 300 is written with 64 digits, not 44.
+			Assert::IsTrue(logger.Log("read", hvn3::ByteSize(1536), 300));
+
+			logger.Flush();
+
+			Assert::AreEqual(std::size_t(3), lines.size());
+			Assert::AreEqual(std::string("read 1.5") + std::string(hvn3::SizeLogger::MAX_PRECISION - 1, '0') + " KiB", lines[2]);
+
+		}
+
+		// Every record is either written or counted as dropped, and the rest are written when the logger is destroyed.
+		std::size_t written = 0;
+		std::uint64_t dropped = 0;
+
+		{
+			hvn3::SizeLogger logger([&written](std::string_view) { ++written; }, 16);
+			std::vector<std::thread> threads;
+
+			for (int i = 0; i < 4; ++i)
+				threads.emplace_back([&logger] {
+					for (int j = 0; j < 1000; ++j)
+						logger.Log("size", hvn3::ByteSize(j));
+				});
+
+			for (std::thread& thread : threads)
+				thread.join();
+
+			dropped = logger.Dropped();
+
+		}
+
+		Assert::AreEqual(std::size_t(4000), written + static_cast<std::size_t>(dropped));
+
+	}
+
+	TEST_METHOD(TestMethodSharedCounters) {
+
+#if defined(__linux__)
+
+		std::string name = "ByteSizeUnitTests." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+		hvn3::SharedCounterRegion region(name, 2);
+
+		std::size_t cache = region.AddCounter("cache", hvn3::ByteSize(1024, hvn3::BytePrefix::Decimal));
+		std::size_t sent = region.AddCounter("sent", hvn3::BitSize(0));
+
+		region.BeginUpdate();
+		region.Add(cache, hvn3::ByteSize(500));
+		region.Set(sent, hvn3::BitSize(125));
+		region.EndUpdate();
+
+		std::vector<hvn3::SharedCounter> counters = hvn3::SharedCounterReader(name).Read();
+
+		Assert::AreEqual(std::size_t(2), counters.size());
+		Assert::AreEqual(std::string("cache"), counters[0].name);
+		Assert::AreEqual(std::string("1.52 kB"), counters[0].ToString());
+		Assert::AreEqual(std::string("sent"), counters[1].name);
+		Assert::AreEqual(std::string("1000.00 b"), counters[1].ToString());
+
+		Assert::ExpectException<std::length_error>([&region] { region.AddCounter("full"); });
+		Assert::ExpectException<std::system_error>([] { hvn3::SharedCounterReader("ByteSizeUnitTests.missing"); });
+
+#endif
+
+	}
+
+	TEST_METHOD(TestMethodMetricsExporter) {
+
+		hvn3::AtomicByteSize sent(hvn3::ByteSize(0));
+		hvn3::ByteSizeHistogram histogram;
+
+		histogram.Record(hvn3::ByteSize(1024));
+		histogram.Record(hvn3::ByteSize(3000));
+		histogram.Record(hvn3::ByteSize(100000));
+
+		hvn3::MetricsExporter exporter(true);
+
+		exporter.AddCounter("sent", [&sent] { return sent.Load(); }, {}, "Bytes sent.");
+		exporter.AddGauge("cache_size", [] { return hvn3::ByteSize(1000); }, { { "cache", "a\"b" } });
+		exporter.AddGauge("cache_size", [] { return hvn3::ByteSize::FromExactBits(12); }, { { "cache", "c" } });
+		exporter.AddHistogram("request_size", histogram, { hvn3::ByteSize(4096), hvn3::ByteSize(1024) });
+
+		sent.FetchAdd(hvn3::ByteSize(1536));
+
+		Assert::AreEqual(std::string(
+			"# HELP sent_bytes Bytes sent. (1.50 KiB)\n"
+			"# TYPE sent_bytes counter\n"
+			"# UNIT sent_bytes bytes\n"
+			"sent_bytes_total 1536\n"
+			"# TYPE cache_size_bytes gauge\n"
+			"# UNIT cache_size_bytes bytes\n"
+			"cache_size_bytes{cache=\"a\\\"b\"} 1000\n"
+			"cache_size_bytes{cache=\"c\"} 1.500\n"
+			"# TYPE request_size_bytes histogram\n"
+			"# UNIT request_size_bytes bytes\n"
+			"request_size_bytes_bucket{le=\"1024\"} 1\n"
+			"request_size_bytes_bucket{le=\"4096\"} 2\n"
+			"request_size_bytes_bucket{le=\"+Inf\"} 3\n"
+			"request_size_bytes_count 3\n"
+			"request_size_bytes_sum 104024\n"
+			"# EOF\n"), std::string(exporter.Render()));
+
+		Assert::ExpectException<std::invalid_argument>([&exporter] { exporter.AddCounter("cache_size", [] { return hvn3::ByteSize(0); }); });
+		Assert::ExpectException<std::invalid_argument>([&exporter] { exporter.AddCounter("1st", [] { return hvn3::ByteSize(0); }); });
+
+	}
+
+	TEST_METHOD(TestMethodSizeFormat) {
+
+		Assert::AreEqual(std::string("1.50 KiB"), hvn3::SizeFormat().ToString(hvn3::ByteSize(1536)));
+		Assert::AreEqual(std::string(" 1,023.5 KiB"), hvn3::SizeFormat(">12,.1iec").ToString(hvn3::ByteSize(1048064)));
+		Assert::AreEqual(std::string("1.5 KB"), hvn3::SizeFormat(".1jedec").ToString(hvn3::ByteSize(1536)));
+		Assert::AreEqual(std::string("1.54kB"), hvn3::SizeFormat("#metric").ToString(hvn3::ByteSize(1536)));
+		Assert::AreEqual(std::string("1.54 kbit"), hvn3::SizeFormat("metric").ToString(hvn3::BitSize(192)));
+		Assert::AreEqual(std::string("12.3 MiB"), hvn3::SizeFormat(".3s").ToString(hvn3::ByteSize(12897485)));
+		Assert::AreEqual(std::string("10.0 KiB"), hvn3::SizeFormat(".3s").ToString(hvn3::ByteSize(10235)));
+		Assert::AreEqual(std::string("1020 KiB"), hvn3::SizeFormat(".3s").ToString(hvn3::ByteSize::FromKilobytes(1023.5)));
+		Assert::AreEqual(std::string("1000 B"), hvn3::SizeFormat(".2s").ToString(hvn3::ByteSize(1000)));
+		Assert::AreEqual(std::string("1,000 B"), hvn3::SizeFormat(",.1s").ToString(hvn3::ByteSize(1023)));
+		Assert::AreEqual(std::string("1,234,567 B"), hvn3::SizeFormat(",.0@B").ToString(hvn3::ByteSize(1234567)));
+		Assert::AreEqual(std::string("0.50 MB"), hvn3::SizeFormat("@MB").ToString(hvn3::ByteSize(500000)));
+		Assert::AreEqual(std::string("8.00 Mibit"), hvn3::SizeFormat("@MiB").ToString(hvn3::BitSize(1048576)));
+		Assert::AreEqual(std::string("1.50 B    "), hvn3::SizeFormat("<10@B").ToString(hvn3::ByteSize::FromExactBits(12)));
+		Assert::AreEqual(std::string("**1.5 MB**"), hvn3::SizeFormat("*^10.1metric").ToString(hvn3::ByteSize(1500000)));
+
+		// Formatting into a buffer that is too small fails without writing past it.
+		char buffer[4];
+
+		Assert::IsTrue(hvn3::SizeFormat().Format(hvn3::ByteSize(1536), buffer, buffer + sizeof(buffer)).ec == std::errc::value_too_large);
+
+		hvn3::SizeFormat format;
+
+		Assert::IsTrue(hvn3::SizeFormat::TryParse(">12,.1iec", format).error == hvn3::ParseError::None);
+		Assert::IsTrue(hvn3::SizeFormat::TryParse(".", format).error == hvn3::ParseError::InvalidNumber);
+		Assert::IsTrue(hvn3::SizeFormat::TryParse("1000", format).error == hvn3::ParseError::NumberOutOfRange);
+		Assert::IsTrue(hvn3::SizeFormat::TryParse("@XB", format).error == hvn3::ParseError::InvalidSuffix);
+		Assert::IsTrue(hvn3::SizeFormat::TryParse("iecx", format).error == hvn3::ParseError::TrailingCharacters);
+		Assert::ExpectException<std::invalid_argument>([] { hvn3::SizeFormat("x"); });
+
+#if defined(__cpp_lib_format)
+		Assert::AreEqual(std::string("1.5 KiB, 1.54 kB"), std::format("{:.1iec}, {:metric}", hvn3::ByteSize(1536), hvn3::ByteSize(1536)));
+#endif
+#if defined(BYTESIZE_FMT)
+		Assert::AreEqual(std::string("1.5 KiB, 1.54 kB"), fmt::format("{:.1iec}, {:metric}", hvn3::ByteSize(1536), hvn3::ByteSize(1536)));
+#endif
+
+	}
+
+	TEST_METHOD(TestMethodRateLimiter) {
+
+		typedef hvn3::RateLimiter::clock clock;
+
+		clock::time_point start = clock::now();
+		hvn3::RateLimiter limiter(hvn3::ByteRate::Parse("1 MiB/s"), hvn3::ByteSize::Parse("64 KiB"), start);
+
+		// The bucket starts full, and 1 MiB/s refills 16 KiB of it every 1/64 of a second.
+		Assert::IsTrue(limiter.TryAcquire(hvn3::ByteSize(48 * 1024), start));
+		Assert::IsFalse(limiter.TryAcquire(hvn3::ByteSize(32 * 1024), start));
+		Assert::IsTrue(limiter.TryAcquire(hvn3::ByteSize(16 * 1024), start));
+		Assert::AreEqual(0.0, limiter.Available(start).Bytes());
+		Assert::IsTrue(limiter.TryAcquire(hvn3::ByteSize(16 * 1024), start + std::chrono::microseconds(15625)));
+
+		// Sizes larger than the burst can only be reserved, and put the bucket in debt.
+		clock::time_point later = start + std::chrono::seconds(10);
+
+		Assert::IsFalse(limiter.TryAcquire(hvn3::ByteSize(128 * 1024), later));
+		Assert::IsTrue(limiter.Reserve(hvn3::ByteSize(128 * 1024), later) == std::chrono::microseconds(62500));
+		Assert::AreEqual(0.0, limiter.Available(later + std::chrono::microseconds(62500)).Bytes());
+
+		// Timeouts too long to be counted in nanoseconds wait for as long as it takes.
+		hvn3::RateLimiter unlimited(hvn3::ByteRate::Parse("1 MiB/s"), hvn3::ByteSize::Parse("64 KiB"));
+
+		Assert::IsTrue(unlimited.TryAcquireFor(hvn3::ByteSize(1024), std::chrono::hours::max()));
+		Assert::IsFalse(unlimited.TryAcquireFor(hvn3::ByteSize(128 * 1024), std::chrono::hours::min()));
+
+		// Doubling the rate halves the debt.
+		limiter.SetRate(hvn3::ByteRate::Parse("2 MiB/s"), later);
+
+		Assert::AreEqual(2097152.0, limiter.Rate().BytesPerSecond());
+		Assert::AreEqual(65536.0, limiter.Available(later + std::chrono::microseconds(62500)).Bytes());
+
+		// Bit rates and sizes work the same way.
+		hvn3::RateLimiter bit_limiter(hvn3::BitRate::Parse("2 Gbit/s"), hvn3::BitSize::Parse("1 Mbit"), start);
+
+		Assert::IsTrue(bit_limiter.TryAcquire(hvn3::BitSize::Parse("1 Mbit"), start));
+		Assert::IsFalse(bit_limiter.TryAcquire(hvn3::BitSize::FromExactBits(1), start));
+		Assert::IsTrue(bit_limiter.TryAcquire(hvn3::BitSize::FromExactBits(2), start + std::chrono::nanoseconds(1)));
+
+		// Many threads acquiring at once never get more than the burst between them.
+		hvn3::RateLimiter shared(hvn3::ByteRate::Parse("1 B/s"), hvn3::ByteSize(1000), start);
+		std::atomic<int> acquired(0);
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&] {
+				for (int j = 0; j < 1000; ++j)
+					if (shared.TryAcquire(hvn3::ByteSize(1), start))
+						++acquired;
+			});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		Assert::AreEqual(1000, acquired.load());
+
+		// Blocking acquisitions wait for the bucket to refill, but not for longer than the timeout.
+		hvn3::RateLimiter blocking(hvn3::ByteRate::Parse("1 MiB/s"), hvn3::ByteSize(1024));
+
+		blocking.Acquire(hvn3::ByteSize(1024));
+
+		Assert::IsTrue(blocking.TryAcquireFor(hvn3::ByteSize(512), std::chrono::milliseconds(100)));
+		Assert::IsFalse(blocking.TryAcquireFor(hvn3::ByteSize(1024 * 1024), std::chrono::milliseconds(1)));
+
+		Assert::ExpectException<std::invalid_argument>([] { hvn3::RateLimiter(hvn3::ByteRate(0.0), hvn3::ByteSize(1)); });
+		Assert::ExpectException<std::invalid_argument>([&limiter] { limiter.SetBurst(hvn3::ByteSize(-1)); });
+
+	}
+
+	TEST_METHOD(TestMethodFormatMany) {
+
+		const std::int64_t counts[] = { 0, 1, 1000, 1024, 1536, -2048, 123456789, std::int64_t(1) << 62 };
+		const std::size_t size = sizeof(counts) / sizeof(counts[0]);
+		char buffer[256];
+		std::size_t offsets[size + 1];
+
+		for (hvn3::ByteUnit unit : { hvn3::ByteUnit::IEC, hvn3::ByteUnit::Metric, hvn3::ByteUnit::JEDEC }) {
+
+			std::to_chars_result result = hvn3::ByteSize::FormatMany(counts, size, buffer, buffer + sizeof(buffer), offsets, 2, unit);
+
+			Assert::IsTrue(result.ec == std::errc());
+			Assert::IsTrue(result.ptr == buffer + offsets[size]);
+
+			for (std::size_t i = 0; i < size; ++i) {
+
+				hvn3::BytePrefix prefix = unit == hvn3::ByteUnit::Metric ? hvn3::BytePrefix::Decimal : hvn3::BytePrefix::Binary;
+
+				Assert::AreEqual(hvn3::ByteSize(counts[i], prefix, unit).ToString(), std::string(buffer + offsets[i], buffer + offsets[i + 1]));
+
+			}
+
+		}
+
+		char records[3 * 12];
+
+		Assert::IsTrue(hvn3::BitSize::FormatManyFixedWidth(counts + 2, 3, records, 12, 1).ec == std::errc());
+		Assert::AreEqual(std::string("    1000.0 b   1.0 Kibit   1.5 Kibit"), std::string(records, sizeof(records)));
+		Assert::IsTrue(hvn3::ByteSize::FormatManyFixedWidth(counts, size, records, 4).ec == std::errc::value_too_large);
+
+	}
+
+	TEST_METHOD(TestMethodFormatColumn) {
+
+		const std::int64_t counts[] = { 512, 1536, 1048576, 123456789 };
+		hvn3::ColumnLayout layout = hvn3::ByteSize::MeasureColumn(counts, 4);
+
+		Assert::AreEqual(std::string("MiB"), std::string(layout.symbol));
+		Assert::AreEqual(std::size_t(10), layout.width);
+
+		// Records are written at the stride, leaving the characters in between (here, the column separators) untouched.
+		char table[] = "|----------|----------|----------|----------|";
+
+		hvn3::ByteSize::FormatColumn(counts, 4, layout, table + 1, layout.width + 1);
+
+		Assert::AreEqual(std::string("|  0.00 MiB|  0.00 MiB|  1.00 MiB|117.74 MiB|"), std::string(table, 45));
+
+		const std::int64_t bits[] = { 1000, -2500000, 8 };
+
+		layout = hvn3::BitSize::MeasureColumn(bits, 3, 1, hvn3::ByteUnit::Metric);
+
+		char records[3 * 10];
+
+		hvn3::BitSize::FormatColumn(bits, 3, layout, records, layout.width);
+
+		Assert::AreEqual(std::string(" 0.0 Mbit-2.5 Mbit 0.0 Mbit"), std::string(records, 3 * layout.width));
+
+		// Large columns split between threads are written the same as on one thread.
+		std::vector<std::int64_t> column(200000);
+
+		for (std::size_t i = 0; i < column.size(); ++i)
+			column[i] = static_cast<std::int64_t>(i * i);
+
+		layout = hvn3::ByteSize::MeasureColumn(column.data(), column.size(), 3, hvn3::ByteUnit::Metric);
+
+		std::vector<char> single(column.size() * layout.width);
+		std::vector<char> threaded(column.size() * layout.width);
+
+		hvn3::ByteSize::FormatColumn(column.data(), column.size(), layout, single.data(), layout.width);
+		hvn3::ByteSize::FormatColumn(column.data(), column.size(), layout, threaded.data(), layout.width, 4);
+
+		Assert::AreEqual(std::string("GB"), std::string(layout.symbol));
+		Assert::IsTrue(single == threaded);
+		Assert::AreEqual(std::string("40.000 GB"), std::string(single.end() - layout.width, single.end()));
+
+	}
+
+	TEST_METHOD(TestMethodParseMany) {
+
+		const char* input =
+			"4.0K\t./docs\n"
+			"1.5M\t./src\n"
+			"oops\t./broken\n"
+			"\"512\"\t./quoted\r\n"
+			"2G\t./partial";
+		hvn3::BitCount counts[8];
+		std::size_t invalid_rows[8];
+		hvn3::ParseManyOptions options;
+
+		options.final = false;
+
+		hvn3::ParseManyResult result = hvn3::ByteSize::ParseMany(input, counts, 8, invalid_rows, 8, options);
+
+		Assert::AreEqual(std::size_t(4), result.rows);
+		Assert::AreEqual(std::size_t(1), result.invalidRows);
+		Assert::AreEqual(std::size_t(2), invalid_rows[0]);
+		Assert::AreEqual(std::string("2G\t./partial"), std::string(input + result.position));
+		Assert::IsTrue(counts[0] == hvn3::ByteSize::FromKilobytes(4).ExactBits());
+		Assert::IsTrue(counts[1] == hvn3::ByteSize::FromMegabytes(1.5).ExactBits());
+		Assert::IsTrue(counts[3] == 512 * 8);
+
+		options.column = 1;
+		options.delimiter = ',';
+
+		result = hvn3::BitSize::ParseMany("a,10 Mbit\nb\n", counts, 8, invalid_rows, 8, options);
+
+		Assert::AreEqual(std::size_t(2), result.rows);
+		Assert::IsTrue(counts[0] == 10000000);
+		Assert::AreEqual(std::size_t(1), invalid_rows[0]);
+
+	}
+
+	TEST_METHOD(TestMethodParseAtCompileTime) {
+
+		using namespace hvn3::literals;
+
+		constexpr hvn3::ByteSize buffer = hvn3::ByteSize::Parse("256 MiB");
+		static_assert(buffer.ExactBits() == hvn3::BitCount(256) * 1024 * 1024 * 8, "256 MiB should be parsed at compile time");
+
+		constexpr hvn3::ByteSize download = "1.5 GB"_bytes;
+		static_assert(download.ExactBits() == hvn3::BitCount(12000000000), "1.5 GB should be 1.5e9 bytes");
+		static_assert(download.Unit() == hvn3::ByteUnit::Metric, "GB should be a metric unit");
+
+		constexpr hvn3::BitSize link = "2.5e1 Mbit"_bits;
+		static_assert(link.ExactBits() == hvn3::BitCount(25000000), "2.5e1 Mbit should be 25 million bits");
+
+		Assert::AreEqual(std::string("1.50 GB"), download.ToString());
+		Assert::AreEqual(512.0, hvn3::ByteSize::Parse(".5 KiB").Bytes());
+		Assert::AreEqual(std::string("1.23 KiB"), hvn3::ByteSize::Parse("1.234567890123456789012 KiB").ToString());
+
+	}
+
 	};
 
 }
\ No newline at end of file
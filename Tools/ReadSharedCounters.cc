@@ -0,0 +1,61 @@
+#include "SharedCounters.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Prints the counters in a shared counter region (see SharedCounterRegion), once or at an interval.
+// Usage: ReadSharedCounters <region> [interval in seconds]
+
+int main(int argc, char* argv[]) {
+
+	if (argc < 2) {
+
+		std::fprintf(stderr, "Usage: %s <region> [interval in seconds]\n", argv[0]);
+
+		return 2;
+
+	}
+
+	double interval = argc > 2 ? std::atof(argv[2]) : 0.0;
+
+	try {
+
+		hvn3::SharedCounterReader reader(argv[1]);
+		std::vector<hvn3::SharedCounter> counters;
+
+		for (;;) {
+
+			if (!reader.TryRead(counters)) {
+
+				std::fprintf(stderr, "The counters were being updated on every attempt to read them.\n");
+
+				return 1;
+
+			}
+
+			for (const hvn3::SharedCounter& counter : counters)
+				std::printf("%-48s %s\n", counter.name.c_str(), counter.ToString().c_str());
+
+			if (interval <= 0.0)
+				return 0;
+
+			std::printf("\n");
+			std::fflush(stdout);
+
+			std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+
+		}
+
+	}
+	catch (const std::exception& ex) {
+
+		std::fprintf(stderr, "%s\n", ex.what());
+
+		return 1;
+
+	}
+
+}